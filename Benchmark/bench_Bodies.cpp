@@ -0,0 +1,140 @@
+#include "benchmark_utility.hpp"
+#include "Circle.hpp"
+#include "CollisionDetector.hpp"
+#include "Polygon.hpp"
+#include "Simulation.hpp"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+const int BODY_COUNT = 10000;
+const int LARGE_SCENE_BODY_COUNT = 100000;
+const float DT = 1.0f / 120.0f; // In seconds
+
+// Memory of a shape definition including the vertices and normals which don't fit into the inline storage
+double bytesPerShape(const ShapeDefinition & i_shape) {
+    std::size_t heapBytes = 0;
+    for (vertexSpan vertices : {i_shape.getVertices(), i_shape.getNormals()}) {
+        heapBytes += vertices.size > InlineVertexArray::INLINE_CAPACITY ? vertices.size * sizeof(sf::Vector2f) : 0;
+    }
+    return static_cast<double>(sizeof(ShapeDefinition) + heapBytes);
+}
+
+// Memory of a body in a scene of BODY_COUNT bodies sharing one shape definition
+template <typename T> double bytesPerBody(const T & i_body) {
+    return sizeof(T) + bytesPerShape(i_body.getShape()) / BODY_COUNT;
+}
+
+// Integrates a scene of moving bodies, which only touches the hot state of every body. Also reports the memory per body.
+void BM_UpdateBodies(bench::benchmarkState & io_state) {
+    std::shared_ptr<const ShapeDefinition> crate = ShapeDefinition::createPolygon(
+            {sf::Vector2f(25.0f, -25.0f), sf::Vector2f(-25.0f, -25.0f), sf::Vector2f(-25.0f, 25.0f), sf::Vector2f(25.0f, 25.0f)});
+    std::shared_ptr<const ShapeDefinition> ball = ShapeDefinition::createCircle(25.0f);
+    std::vector<std::unique_ptr<RigidBody>> bodies;
+    for (int i = 0; i < BODY_COUNT; i++) {
+        if (i % 2 == 0) {
+            bodies.emplace_back(new Polygon(0.1f, crate));
+        } else {
+            bodies.emplace_back(new Circle(0.1f, ball));
+        }
+        bodies.back()->setPosition(10.0f * (i % 100), 10.0f * (i / 100));
+        bodies.back()->setVelocity(sf::Vector2f(1.0f * (i % 7), -1.0f * (i % 5)));
+        bodies.back()->setAngularVelocity(10.0f * (i % 3));
+    }
+    io_state.setItemsPerIteration(BODY_COUNT);
+    while (io_state.keepRunning()) {
+        for (std::unique_ptr<RigidBody> & body : bodies) {
+            body->updateBody(DT);
+        }
+        bench::doNotOptimize(bodies[0]->getPosition());
+    }
+    io_state.setCounter("hotStateBytes", sizeof(bodyState));
+    io_state.setCounter("polygonBytes", bytesPerBody(Polygon(0.1f, crate)));
+    io_state.setCounter("circleBytes", bytesPerBody(Circle(0.1f, ball)));
+}
+REGISTER_BENCHMARK(BM_UpdateBodies);
+
+// Collision detection and resolution of touching neighbours in a scene which is much larger than the cache. The pairs are visited in
+// random order, so almost every body access is a cache miss and the time per pair mostly depends on how many cache lines the hot data of a
+// body spans. Run it with `perf stat -e cache-misses` to see the miss rate.
+void BM_NarrowphaseAndSolve(bench::benchmarkState & io_state) {
+    const float RADIUS = 10.0f; // In pixels
+    std::shared_ptr<const ShapeDefinition> crate = ShapeDefinition::createPolygon(
+            {sf::Vector2f(RADIUS, -RADIUS), sf::Vector2f(-RADIUS, -RADIUS), sf::Vector2f(-RADIUS, RADIUS), sf::Vector2f(RADIUS, RADIUS)});
+    std::shared_ptr<const ShapeDefinition> ball = ShapeDefinition::createCircle(RADIUS);
+    std::vector<std::unique_ptr<RigidBody>> bodies;
+    for (int i = 0; i < LARGE_SCENE_BODY_COUNT; i++) {
+        if (i % 3 == 0) {
+            bodies.emplace_back(new Polygon(0.1f, crate));
+        } else {
+            bodies.emplace_back(new Circle(0.1f, ball));
+        }
+        // A row of bodies, every body overlaps its neighbours by one pixel
+        bodies.back()->setPosition((2 * RADIUS - 1.0f) * i, 0.0f);
+    }
+    std::vector<int> pairOrder(LARGE_SCENE_BODY_COUNT - 1);
+    for (int i = 0; i < LARGE_SCENE_BODY_COUNT - 1; i++) {
+        pairOrder[i] = i;
+    }
+    std::shuffle(pairOrder.begin(), pairOrder.end(), std::mt19937(42));
+
+    CollisionDetector & cd = CollisionDetector::getInstance();
+    io_state.setItemsPerIteration(pairOrder.size());
+    while (io_state.keepRunning()) {
+        for (int first : pairOrder) {
+            RigidBody * firstBody = bodies[first].get();
+            RigidBody * secondBody = bodies[first + 1].get();
+            // Let the bodies approach each other, so there is something to resolve
+            firstBody->setVelocity(sf::Vector2f(10.0f, 0.0f));
+            secondBody->setVelocity(sf::Vector2f(-10.0f, 0.0f));
+            CollisionEvent event = cd.generateCollisionEvent(firstBody, secondBody);
+            event.resolve();
+        }
+        bench::doNotOptimize(bodies[0]->getVelocity());
+    }
+    io_state.setCounter("bodyBytes", sizeof(Circle));
+    io_state.setCounter("bodyAlignment", alignof(Circle));
+}
+REGISTER_BENCHMARK(BM_NarrowphaseAndSolve);
+
+// Loading a scene of 100k bodies with the batch API and removing it again
+void BM_CreateScene(bench::benchmarkState & io_state) {
+    Simulation & simulation = Simulation::getInstance();
+    std::shared_ptr<const ShapeDefinition> crate = Polygon().getSharedShape();
+    std::shared_ptr<const ShapeDefinition> ball = ShapeDefinition::createCircle(25.0f);
+    std::vector<bodyDefinition> definitions(LARGE_SCENE_BODY_COUNT);
+    for (int i = 0; i < LARGE_SCENE_BODY_COUNT; i++) {
+        definitions[i].shape = i % 2 == 0 ? crate : ball;
+        definitions[i].position = sf::Vector2f(60.0f * (i % 300), 60.0f * (i / 300));
+    }
+    io_state.setItemsPerIteration(LARGE_SCENE_BODY_COUNT);
+    while (io_state.keepRunning()) {
+        std::vector<bodyHandle> handles = simulation.createCollisionPartners(definitions);
+        for (bodyHandle handle : handles) {
+            simulation.deleteCollisionPartner(handle);
+        }
+    }
+}
+REGISTER_BENCHMARK(BM_CreateScene);
+
+// Creating a body with its own shape definition calculates the whole geometry
+void BM_CreatePolygon(bench::benchmarkState & io_state) {
+    while (io_state.keepRunning()) {
+        Polygon polygon;
+        bench::doNotOptimize(polygon.getInverseMomentOfInertia());
+    }
+}
+REGISTER_BENCHMARK(BM_CreatePolygon);
+
+// Creating a body from a shared shape definition only copies a pointer
+void BM_CreatePolygonSharedShape(bench::benchmarkState & io_state) {
+    std::shared_ptr<const ShapeDefinition> crate = Polygon().getSharedShape();
+    while (io_state.keepRunning()) {
+        Polygon polygon(0.1f, crate);
+        bench::doNotOptimize(polygon.getInverseMomentOfInertia());
+    }
+}
+REGISTER_BENCHMARK(BM_CreatePolygonSharedShape);
+} // namespace
@@ -0,0 +1,84 @@
+#include "benchmark_utility.hpp"
+#include "CollisionDetector.hpp"
+#include "Circle.hpp"
+#include "WideContactSolver.hpp"
+#include <memory>
+#include <vector>
+
+namespace {
+const int CONTACT_COUNT = 1024;
+const float RADIUS = 25.0f; // In pixels
+
+// Independent pairs of overlapping circles moving towards each other, like the contacts of a single color
+struct contactSet {
+    std::vector<std::unique_ptr<Circle>> circles;
+    std::vector<CollisionEvent> events;
+    std::vector<CollisionEvent *> eventPointers;
+    std::vector<sf::Vector2f> initialVelocities;
+
+    contactSet() {
+        CollisionDetector & cd = CollisionDetector::getInstance();
+        for (int i = 0; i < 2 * CONTACT_COUNT; i++) {
+            circles.emplace_back(new Circle(0.1f, RADIUS));
+            circles.back()->setPosition(100.0f * (i / 2) + (i % 2) * (2 * RADIUS - 2.0f), (i % 2) * (i % 11));
+            initialVelocities.push_back(sf::Vector2f(i % 2 == 0 ? 20.0f : -20.0f, 1.0f * (i % 5)));
+        }
+        resetVelocities();
+        for (int i = 0; i < CONTACT_COUNT; i++) {
+            events.push_back(cd.generateCollisionEvent(circles[2 * i].get(), circles[2 * i + 1].get()));
+        }
+        for (CollisionEvent & event : events) {
+            eventPointers.push_back(&event);
+        }
+    }
+
+    // Resolved contacts are separating, so they have to be reset for the next iteration to do the same work
+    void resetVelocities() {
+        for (std::size_t i = 0; i < circles.size(); i++) {
+            circles[i]->setVelocity(initialVelocities[i]);
+            circles[i]->setAngularVelocity(0.0f);
+        }
+    }
+};
+
+// Baseline: what every benchmark below spends on resetting the velocities
+void BM_ResetVelocities(bench::benchmarkState & io_state) {
+    contactSet contacts;
+    io_state.setItemsPerIteration(CONTACT_COUNT);
+    while (io_state.keepRunning()) {
+        contacts.resetVelocities();
+        bench::doNotOptimize(contacts.circles[0]->getVelocity());
+    }
+}
+REGISTER_BENCHMARK(BM_ResetVelocities);
+
+// One contact after another with CollisionEvent::resolve()
+void BM_ResolveSingle(bench::benchmarkState & io_state) {
+    contactSet contacts;
+    io_state.setItemsPerIteration(CONTACT_COUNT);
+    while (io_state.keepRunning()) {
+        contacts.resetVelocities();
+        for (CollisionEvent & event : contacts.events) {
+            event.resolve();
+        }
+        bench::doNotOptimize(contacts.circles[0]->getVelocity());
+    }
+}
+REGISTER_BENCHMARK(BM_ResolveSingle);
+
+// Batches of contacts with the WideContactSolver
+void resolveWide(bench::benchmarkState & io_state, simdLevel i_simdLevel) {
+    contactSet contacts;
+    WideContactSolver solver(i_simdLevel);
+    io_state.setItemsPerIteration(CONTACT_COUNT);
+    io_state.setCounter("lanes", solver.getLaneCount());
+    while (io_state.keepRunning()) {
+        contacts.resetVelocities();
+        solver.solve(contacts.eventPointers.data(), contacts.eventPointers.size());
+        bench::doNotOptimize(contacts.circles[0]->getVelocity());
+    }
+}
+REGISTER_BENCHMARK_NAMED("BM_ResolveWide/scalar", [](bench::benchmarkState & io_state) { resolveWide(io_state, simdLevel::scalar); });
+REGISTER_BENCHMARK_NAMED("BM_ResolveWide/sse", [](bench::benchmarkState & io_state) { resolveWide(io_state, simdLevel::sse); });
+REGISTER_BENCHMARK_NAMED("BM_ResolveWide/avx2", [](bench::benchmarkState & io_state) { resolveWide(io_state, simdLevel::avx2); });
+} // namespace
@@ -0,0 +1,153 @@
+#include "benchmark_utility.hpp"
+#include "BoundaryElement.hpp"
+#include "Circle.hpp"
+#include "CollisionDetector.hpp"
+#include "Polygon.hpp"
+#include "sfml_utility.hpp"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+const int PAIR_COUNT = 64;
+
+// Overlapping pairs of rotated polygons. Few enough to stay in the cache, so the time per pair is dominated by the vector math of the SAT
+// (transformations, projections, scalar products) instead of memory accesses.
+std::vector<std::unique_ptr<RigidBody>> createOverlappingPolygons() {
+    std::vector<sf::Vector2f> vertices;
+    for (int i = 0; i < 6; i++) {
+        vertices.push_back(sfu::rotateVector(sf::Vector2f(20.0f, 0.0f), -60.0f * i));
+    }
+    std::shared_ptr<const ShapeDefinition> hexagon = ShapeDefinition::createPolygon(vertices);
+    std::vector<std::unique_ptr<RigidBody>> bodies;
+    for (int i = 0; i < PAIR_COUNT; i++) {
+        bodies.emplace_back(new Polygon(0.1f, hexagon));
+        bodies.back()->setPosition(0.0f, 100.0f * i);
+        bodies.back()->setOrientation(0.1f * i);
+        bodies.emplace_back(new Polygon(0.1f, hexagon));
+        bodies.back()->setPosition(35.0f, 100.0f * i + 5.0f);
+        bodies.back()->setOrientation(0.05f * i);
+    }
+    return bodies;
+}
+
+const float BOUNDARY_LENGTH = 200.0f; // In pixels
+
+// Distance from the center to the closest edge. A body whose center is closer than the sum of both inner radii overlaps the other body
+// at any orientation.
+float getInnerRadius(const ShapeDefinition & i_shape) {
+    if (i_shape.getType() != shapeType::polygon) {
+        return i_shape.getType() == shapeType::circle ? i_shape.getRadius() : 0.0f;
+    }
+    float innerRadius = i_shape.getBoundingRadius();
+    for (const sf::Vector2f & normal : i_shape.getNormals()) {
+        float support = 0.0f;
+        for (const sf::Vector2f & vertex : i_shape.getVertices()) {
+            support = std::max(support, sfu::scalarProduct(vertex, normal));
+        }
+        innerRadius = std::min(innerRadius, support);
+    }
+    return innerRadius;
+}
+
+std::unique_ptr<RigidBody> createBody(const std::shared_ptr<const ShapeDefinition> & i_shape) {
+    switch (i_shape->getType()) {
+    case shapeType::circle:
+        return std::unique_ptr<RigidBody>(new Circle(0.1f, i_shape));
+    case shapeType::segment:
+        return std::unique_ptr<RigidBody>(new BoundaryElement(BOUNDARY_LENGTH));
+    default:
+        return std::unique_ptr<RigidBody>(new Polygon(0.1f, i_shape));
+    }
+}
+
+// PAIR_COUNT pairs of bodies at different orientations and directions. Overlapping pairs are closer than their inner radii, separated
+// pairs are farther apart than their bounding radii. A segment as first shape becomes a BoundaryElement, with the second body in front of
+// it.
+std::vector<std::unique_ptr<RigidBody>> createPairs(const std::shared_ptr<const ShapeDefinition> & i_firstShape,
+        const std::shared_ptr<const ShapeDefinition> & i_secondShape, bool i_isOverlapping) {
+    bool isBoundary = i_firstShape->getType() == shapeType::segment;
+    float distance = i_isOverlapping ? 0.8f * (getInnerRadius(*i_firstShape) + getInnerRadius(*i_secondShape))
+                                     : 1.2f * (i_firstShape->getBoundingRadius() + i_secondShape->getBoundingRadius());
+    if (isBoundary && !i_isOverlapping) {
+        distance = 1.2f * i_secondShape->getBoundingRadius();
+    }
+    std::vector<std::unique_ptr<RigidBody>> bodies;
+    for (int i = 0; i < PAIR_COUNT; i++) {
+        sf::Vector2f position(0.0f, 400.0f * i);
+        bodies.push_back(createBody(i_firstShape));
+        bodies.back()->setPosition(position.x, position.y);
+        // The boundary keeps its orientation and the second body is placed along its normal, spread over its length
+        sf::Vector2f direction = isBoundary ? i_firstShape->getNormals()[0] : sfu::rotateVector(sf::Vector2f(1.0f, 0.0f), 37.0f * i);
+        if (isBoundary) {
+            position += sfu::rotateVector(direction, 90.0f) * (0.4f * BOUNDARY_LENGTH * (i % 5 - 2) / 2.0f);
+        } else {
+            bodies.back()->setOrientation(0.3f * i);
+        }
+        bodies.push_back(createBody(i_secondShape));
+        bodies.back()->setPosition(position.x + distance * direction.x, position.y + distance * direction.y);
+        bodies.back()->setOrientation(0.7f * i);
+    }
+    return bodies;
+}
+
+// Collision detection of one shape pairing. Reports the fraction of pairs that were found to overlap, to check the configuration.
+void runKernel(bench::benchmarkState & io_state, std::shared_ptr<const ShapeDefinition> i_firstShape,
+        std::shared_ptr<const ShapeDefinition> i_secondShape, bool i_isOverlapping) {
+    std::vector<std::unique_ptr<RigidBody>> bodies = createPairs(i_firstShape, i_secondShape, i_isOverlapping);
+    CollisionDetector & cd = CollisionDetector::getInstance();
+    int overlapCount = 0;
+    io_state.setItemsPerIteration(PAIR_COUNT);
+    while (io_state.keepRunning()) {
+        overlapCount = 0;
+        for (int i = 0; i < PAIR_COUNT; i++) {
+            CollisionEvent event = cd.generateCollisionEvent(bodies[2 * i].get(), bodies[2 * i + 1].get());
+            overlapCount += event.getMinSeparation() <= 0.0f ? 1 : 0;
+            bench::doNotOptimize(event.getMinSeparation());
+        }
+    }
+    io_state.setCounter("overlapFraction", static_cast<double>(overlapCount) / PAIR_COUNT);
+}
+
+// Registers an overlapping and a separated benchmark of a shape pairing, e.g. "BM_NarrowphaseKernel/polygonCircle/8/overlapping"
+void registerKernel(const std::string & i_name, std::shared_ptr<const ShapeDefinition> i_firstShape,
+        std::shared_ptr<const ShapeDefinition> i_secondShape) {
+    for (bool isOverlapping : {true, false}) {
+        bench::registerParameterized("BM_NarrowphaseKernel/" + i_name + (isOverlapping ? "/overlapping" : "/separated"), runKernel,
+                i_firstShape, i_secondShape, isOverlapping);
+    }
+}
+
+// Every path through CollisionDetector::generateCollisionEvent()
+void registerKernels() {
+    const float RADIUS = 20.0f; // In pixels
+    std::shared_ptr<const ShapeDefinition> circle = ShapeDefinition::createCircle(RADIUS);
+    std::shared_ptr<const ShapeDefinition> segment = ShapeDefinition::createSegment(BOUNDARY_LENGTH);
+    for (int vertexCount : {3, 4, 8, 16, 32}) {
+        std::shared_ptr<const ShapeDefinition> polygon = bench::createRegularPolygon(vertexCount, RADIUS);
+        registerKernel("polygonPolygon/" + std::to_string(vertexCount), polygon, polygon);
+    }
+    std::shared_ptr<const ShapeDefinition> octagon = bench::createRegularPolygon(8, RADIUS);
+    registerKernel("polygonCircle/8", octagon, circle);
+    registerKernel("circleCircle", circle, circle);
+    registerKernel("boundaryPolygon/8", segment, octagon);
+    registerKernel("boundaryCircle", segment, circle);
+}
+REGISTER_BENCHMARKS(registerKernels);
+
+// Collision detection only, without resolving the contacts. Compare builds without link time optimization (/GL, -flto) to see the cost of
+// calls into other translation units in the inner loops.
+void BM_Narrowphase(bench::benchmarkState & io_state) {
+    std::vector<std::unique_ptr<RigidBody>> bodies = createOverlappingPolygons();
+    CollisionDetector & cd = CollisionDetector::getInstance();
+    io_state.setItemsPerIteration(PAIR_COUNT);
+    while (io_state.keepRunning()) {
+        for (int i = 0; i < PAIR_COUNT; i++) {
+            CollisionEvent event = cd.generateCollisionEvent(bodies[2 * i].get(), bodies[2 * i + 1].get());
+            bench::doNotOptimize(event.getMinSeparation());
+        }
+    }
+}
+REGISTER_BENCHMARK(BM_Narrowphase);
+} // namespace
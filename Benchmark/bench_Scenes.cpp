@@ -0,0 +1,280 @@
+#include "benchmark_utility.hpp"
+#include "AllocationTracker.hpp"
+#include "BoundaryElement.hpp"
+#include "Circle.hpp"
+#include "Simulation.hpp"
+#include "sfml_utility.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+//*** Scene benchmarks ***
+//
+//Whole headless steps of generated scenes. Every benchmark simulates exactly STEP_COUNT steps (--min-time has no effect), and a scene only
+//depends on its body count and seed, so the numbers of two engine versions can be compared directly. The report shows the time per step
+//(ns/iteration), the time per body and step (ns/item), the steps per second and the memory of the scene.
+//
+//The broadphase tests all pairs of bodies, so the time per body grows with the body count.
+//
+//Define COLLISION2D_TRACK_ALLOCATIONS for the Collision2D and Benchmark projects to also get the measured allocations per step and the heap
+//bytes per body that loading the scene adds (see AllocationTracker). Storage the BodyStore kept from an earlier, larger scene isn't counted
+//again. The peak resident memory is always reported, but it is the peak of the whole run so far.
+//
+namespace {
+const float DT = 1.0f / 120.0f; // In seconds
+const int STEP_COUNT = 120;
+const std::uint32_t SEED = 1;
+const int BODY_COUNTS[] = {50, 200};
+
+// Random numbers which only depend on the seed. std::mt19937 produces the same sequence on every platform, the distributions of the
+// standard library don't, so they aren't used.
+class sceneRandom {
+  public:
+    explicit sceneRandom(std::uint32_t i_seed) : m_engine(i_seed) {}
+
+    float uniform(float i_min, float i_max) {
+        return i_min + (i_max - i_min) * static_cast<float>(m_engine() >> 8) / 16777216.0f;
+    }
+
+    int uniformInt(int i_min, int i_max) {
+        return i_min + static_cast<int>(m_engine() % static_cast<std::uint32_t>(i_max - i_min + 1));
+    }
+
+  private:
+    std::mt19937 m_engine;
+};
+
+// Bodies and boundaries of a generated scene
+struct scene {
+    std::vector<bodyDefinition> bodies;
+    /// Indices of the bodies which use continuous collision detection.
+    std::vector<std::size_t> bullets;
+    std::vector<std::unique_ptr<BoundaryElement>> boundaries;
+};
+
+using sceneGenerator = scene (*)(int i_bodyCount, std::uint32_t i_seed);
+
+// Side length of a square that holds i_bodyCount bodies at the given distance from each other
+float getSceneSize(int i_bodyCount, float i_spacing) {
+    return std::ceil(std::sqrt(static_cast<float>(i_bodyCount))) * i_spacing;
+}
+
+// Walls around the square from {0,0} to {i_size,i_size}, every wall split into i_segmentsPerSide boundary elements
+void addBox(scene & io_scene, float i_size, int i_segmentsPerSide) {
+    float segmentLength = i_size / i_segmentsPerSide;
+    for (int i = 0; i < i_segmentsPerSide; i++) {
+        float offset = (i + 0.5f) * segmentLength;
+        // Position and rotation of the top, bottom, left and right segment, all normals point into the box
+        const float WALLS[4][3] = {{offset, 0.0f, 0.0f}, {offset, i_size, 180.0f}, {0.0f, offset, 270.0f}, {i_size, offset, 90.0f}};
+        for (const float * wall : WALLS) {
+            io_scene.boundaries.emplace_back(new BoundaryElement(segmentLength));
+            io_scene.boundaries.back()->setPosition(wall[0], wall[1]);
+            io_scene.boundaries.back()->setRotation(wall[2]);
+        }
+    }
+}
+
+// Circles of different sizes flying around in a box
+scene createRandomCircles(int i_bodyCount, std::uint32_t i_seed) {
+    sceneRandom random(i_seed);
+    scene circles;
+    float size = getSceneSize(i_bodyCount, 40.0f);
+    std::vector<std::shared_ptr<const ShapeDefinition>> shapes;
+    for (float radius = 5.0f; radius <= 15.0f; radius += 2.5f) {
+        shapes.push_back(ShapeDefinition::createCircle(radius));
+    }
+    for (int i = 0; i < i_bodyCount; i++) {
+        bodyDefinition body;
+        body.shape = shapes[random.uniformInt(0, static_cast<int>(shapes.size()) - 1)];
+        body.inverseMass = 100.0f / body.shape->getArea();
+        body.position = sf::Vector2f(random.uniform(20.0f, size - 20.0f), random.uniform(20.0f, size - 20.0f));
+        body.velocity = sf::Vector2f(random.uniform(-100.0f, 100.0f), random.uniform(-100.0f, 100.0f));
+        circles.bodies.push_back(body);
+    }
+    addBox(circles, size, 1);
+    return circles;
+}
+
+// Polygons with 3 to 8 corners in columns, falling onto the floor of a box
+scene createPolygonPile(int i_bodyCount, std::uint32_t i_seed) {
+    sceneRandom random(i_seed);
+    scene pile;
+    const float SPACING = 36.0f;
+    int columnCount = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(i_bodyCount))));
+    float size = getSceneSize(i_bodyCount, SPACING) + SPACING;
+    std::vector<std::shared_ptr<const ShapeDefinition>> shapes;
+    for (int vertexCount = 3; vertexCount <= 8; vertexCount++) {
+        shapes.push_back(bench::createRegularPolygon(vertexCount, 12.0f));
+        shapes.push_back(bench::createRegularPolygon(vertexCount, 16.0f));
+    }
+    for (int i = 0; i < i_bodyCount; i++) {
+        bodyDefinition body;
+        body.shape = shapes[random.uniformInt(0, static_cast<int>(shapes.size()) - 1)];
+        body.inverseMass = 100.0f / body.shape->getArea();
+        body.position = sf::Vector2f(SPACING * (i % columnCount + 1) + random.uniform(-4.0f, 4.0f), size - SPACING * (i / columnCount + 1));
+        body.velocity = sf::Vector2f(0.0f, 200.0f);
+        body.orientation = random.uniform(0.0f, 2.0f * sfu::PI);
+        pile.bodies.push_back(body);
+    }
+    addBox(pile, size, 1);
+    return pile;
+}
+
+// Mostly small bodies with a few large ones in between, which overlap many small bodies at once
+scene createMixedSizes(int i_bodyCount, std::uint32_t i_seed) {
+    sceneRandom random(i_seed);
+    scene mixed;
+    float size = getSceneSize(i_bodyCount, 50.0f);
+    std::vector<std::shared_ptr<const ShapeDefinition>> smallShapes = {
+            ShapeDefinition::createCircle(4.0f), bench::createRegularPolygon(4, 6.0f), bench::createRegularPolygon(3, 6.0f)};
+    std::vector<std::shared_ptr<const ShapeDefinition>> largeShapes = {
+            ShapeDefinition::createCircle(60.0f), bench::createRegularPolygon(6, 80.0f), bench::createRegularPolygon(5, 50.0f)};
+    for (int i = 0; i < i_bodyCount; i++) {
+        bodyDefinition body;
+        const std::vector<std::shared_ptr<const ShapeDefinition>> & shapes = i % 10 == 0 ? largeShapes : smallShapes;
+        body.shape = shapes[random.uniformInt(0, static_cast<int>(shapes.size()) - 1)];
+        body.inverseMass = 100.0f / body.shape->getArea();
+        body.position = sf::Vector2f(random.uniform(0.1f * size, 0.9f * size), random.uniform(0.1f * size, 0.9f * size));
+        body.velocity = sf::Vector2f(random.uniform(-50.0f, 50.0f), random.uniform(-50.0f, 50.0f));
+        body.orientation = random.uniform(0.0f, 2.0f * sfu::PI);
+        body.angularVelocity = random.uniform(-1.0f, 1.0f);
+        mixed.bodies.push_back(body);
+    }
+    addBox(mixed, size, 1);
+    return mixed;
+}
+
+// Bodies in a box whose walls consist of many short boundary elements, so most candidate pairs are body/boundary pairs
+scene createBoundaryBox(int i_bodyCount, std::uint32_t i_seed) {
+    sceneRandom random(i_seed);
+    scene box;
+    float size = getSceneSize(i_bodyCount, 30.0f);
+    std::shared_ptr<const ShapeDefinition> ball = ShapeDefinition::createCircle(8.0f);
+    std::shared_ptr<const ShapeDefinition> crate = bench::createRegularPolygon(4, 10.0f);
+    for (int i = 0; i < i_bodyCount; i++) {
+        bodyDefinition body;
+        body.shape = i % 2 == 0 ? ball : crate;
+        body.position = sf::Vector2f(random.uniform(15.0f, size - 15.0f), random.uniform(15.0f, size - 15.0f));
+        body.velocity = sf::Vector2f(random.uniform(-200.0f, 200.0f), random.uniform(-200.0f, 200.0f));
+        box.bodies.push_back(body);
+    }
+    addBox(box, size, static_cast<int>(size / 10.0f));
+    return box;
+}
+
+// A quarter of the bodies are fast bullets fired from a corner into a block of crates
+scene createProjectileSpray(int i_bodyCount, std::uint32_t i_seed) {
+    sceneRandom random(i_seed);
+    scene spray;
+    const float SPACING = 24.0f;
+    int targetCount = i_bodyCount - i_bodyCount / 4;
+    int columnCount = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(targetCount))));
+    float size = 3.0f * getSceneSize(targetCount, SPACING);
+    std::shared_ptr<const ShapeDefinition> crate = bench::createRegularPolygon(4, 10.0f);
+    std::shared_ptr<const ShapeDefinition> projectile = ShapeDefinition::createCircle(2.0f);
+    for (int i = 0; i < targetCount; i++) {
+        bodyDefinition body;
+        body.shape = crate;
+        body.position = sf::Vector2f(size / 3.0f + SPACING * (i % columnCount), size / 3.0f + SPACING * (i / columnCount));
+        spray.bodies.push_back(body);
+    }
+    for (int i = targetCount; i < i_bodyCount; i++) {
+        bodyDefinition body;
+        body.shape = projectile;
+        body.inverseMass = 1.0f;
+        body.position = sf::Vector2f(random.uniform(10.0f, 40.0f), random.uniform(10.0f, 40.0f));
+        float speed = random.uniform(2000.0f, 4000.0f);
+        body.velocity = sfu::rotateVector(sf::Vector2f(speed, 0.0f), random.uniform(30.0f, 60.0f));
+        spray.bullets.push_back(spray.bodies.size());
+        spray.bodies.push_back(body);
+    }
+    addBox(spray, size, 1);
+    return spray;
+}
+
+// Memory of the bodies, boundaries and shape definitions of a scene
+double getSceneBytes(const scene & i_scene) {
+    std::set<const ShapeDefinition *> shapes;
+    double bytes = static_cast<double>(i_scene.boundaries.size() * sizeof(BoundaryElement));
+    for (const bodyDefinition & body : i_scene.bodies) {
+        bytes += body.shape->getType() == shapeType::circle ? sizeof(Circle) : sizeof(Polygon);
+        shapes.insert(body.shape.get());
+    }
+    for (const ShapeDefinition * shape : shapes) {
+        bytes += sizeof(ShapeDefinition);
+        for (vertexSpan vertices : {shape->getVertices(), shape->getNormals()}) {
+            bytes += vertices.size > InlineVertexArray::INLINE_CAPACITY ? vertices.size * sizeof(sf::Vector2f) : 0;
+        }
+    }
+    return bytes;
+}
+
+// Measured heap memory of the bodies and their shapes, including the arrays of the BodyStore. Zero without COLLISION2D_TRACK_ALLOCATIONS.
+std::size_t getTrackedBodyBytes() {
+    return AllocationTracker::getMemory(memorySubsystem::bodies).liveBytes +
+           AllocationTracker::getMemory(memorySubsystem::shapes).liveBytes;
+}
+
+// Loads the scene into the Simulation, simulates STEP_COUNT steps and removes the scene again
+void runScene(bench::benchmarkState & io_state, sceneGenerator i_generator, int i_bodyCount) {
+    Simulation & simulation = Simulation::getInstance();
+    // The heap memory of the bodies and shapes before the scene is loaded, so earlier benchmarks don't count
+    std::size_t bodyBytesBefore = getTrackedBodyBytes();
+    scene generatedScene = i_generator(i_bodyCount, SEED);
+    std::vector<bodyHandle> handles = simulation.createCollisionPartners(generatedScene.bodies);
+    for (std::size_t bullet : generatedScene.bullets) {
+        simulation.getCollisionPartner(handles[bullet])->setBullet(true);
+    }
+    for (const std::unique_ptr<BoundaryElement> & boundary : generatedScene.boundaries) {
+        simulation.addBoundaryElement(boundary.get());
+    }
+
+    io_state.setIterationCount(STEP_COUNT);
+    io_state.setItemsPerIteration(generatedScene.bodies.size());
+    std::size_t contactCount = 0;
+    std::size_t allocationCount = 0;
+    std::size_t frameArenaBytes = 0;
+    while (io_state.keepRunning()) {
+        simulation.step(DT);
+        contactCount += simulation.getStats().contactCount;
+        allocationCount += simulation.getStats().allocationCount;
+        frameArenaBytes = std::max(frameArenaBytes, simulation.getStats().frameArenaUsedBytes);
+    }
+    io_state.setCounter("stepsPerSecond", 1e9 / io_state.getNanosecondsPerIteration());
+    io_state.setCounter("contactsPerStep", static_cast<double>(contactCount) / STEP_COUNT);
+    io_state.setCounter("bytesPerBody", getSceneBytes(generatedScene) / generatedScene.bodies.size());
+    io_state.setCounter("frameArenaBytes", static_cast<double>(frameArenaBytes));
+    io_state.setCounter("peakRssBytes", static_cast<double>(AllocationTracker::getPeakResidentBytes()));
+    if (AllocationTracker::IS_ENABLED) {
+        double bodyBytes = static_cast<double>(getTrackedBodyBytes()) - static_cast<double>(bodyBytesBefore);
+        io_state.setCounter("allocsPerStep", static_cast<double>(allocationCount) / STEP_COUNT);
+        io_state.setCounter("trackedBytesPerBody", bodyBytes / generatedScene.bodies.size());
+    }
+
+    for (bodyHandle handle : handles) {
+        simulation.deleteCollisionPartner(handle);
+    }
+    for (const std::unique_ptr<BoundaryElement> & boundary : generatedScene.boundaries) {
+        simulation.removeBoundaryElement(boundary.get());
+    }
+}
+
+// Registers a benchmark of every scene for every body count, named e.g. "BM_Scene/randomCircles/200"
+void registerScenes() {
+    const std::pair<const char *, sceneGenerator> SCENES[] = {{"randomCircles", createRandomCircles}, {"polygonPile", createPolygonPile},
+            {"mixedSizes", createMixedSizes}, {"boundaryBox", createBoundaryBox}, {"projectileSpray", createProjectileSpray}};
+    for (const std::pair<const char *, sceneGenerator> & currentScene : SCENES) {
+        for (int bodyCount : BODY_COUNTS) {
+            bench::registerParameterized(std::string("BM_Scene/") + currentScene.first + "/" + std::to_string(bodyCount), runScene,
+                    currentScene.second, bodyCount);
+        }
+    }
+}
+REGISTER_BENCHMARKS(registerScenes);
+} // namespace
@@ -0,0 +1,39 @@
+#include "benchmark_utility.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+//*** Benchmark runner ***
+//
+//Usage: Benchmark [filter] [--min-time=<milliseconds>]
+//Runs every registered benchmark whose name contains the filter and prints the time per iteration (and per item, if set).
+//Build and run the Release configuration, Debug numbers are meaningless.
+//
+int main(int argc, char ** argv) {
+    const char * filter = "";
+    long minTimeMs = 500;
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--min-time=", 11) == 0) {
+            minTimeMs = std::strtol(argv[i] + 11, nullptr, 10);
+        } else {
+            filter = argv[i];
+        }
+    }
+
+    std::printf("%-48s %14s %14s %12s\n", "Benchmark", "ns/iteration", "ns/item", "iterations");
+    for (const bench::benchmarkEntry & entry : bench::getRegistry()) {
+        if (std::strstr(entry.name.c_str(), filter) == nullptr) {
+            continue;
+        }
+        bench::benchmarkState state{std::chrono::milliseconds(minTimeMs)};
+        entry.function(state);
+        double nsPerIteration = state.getNanosecondsPerIteration();
+        std::printf("%-48s %14.1f %14.2f %12llu", entry.name.c_str(), nsPerIteration, nsPerIteration / state.getItemsPerIteration(),
+                static_cast<unsigned long long>(state.getIterations()));
+        for (const auto & counter : state.getCounters()) {
+            std::printf("  %s=%g", counter.first.c_str(), counter.second);
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#include "ShapeDefinition.hpp"
+#include "sfml_utility.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A tiny benchmark framework, so the benchmarks don't need any dependency besides the standard library.
+ *
+ * A benchmark is a function taking a benchmarkState. The loop `while (io_state.keepRunning()) {...}` runs the measured code until enough
+ * time has passed for a stable result. Benchmarks are registered with REGISTER_BENCHMARK and run by bench_main.cpp.
+ */
+namespace bench {
+
+/**
+ * @brief Controls the measurement loop of a single benchmark run.
+ */
+class benchmarkState {
+  public:
+    /**
+     * @brief Constructor.
+     * @param i_minTime Minimum time the measured loop runs.
+     */
+    explicit benchmarkState(std::chrono::nanoseconds i_minTime) : m_minTime(i_minTime) {}
+
+    /**
+     * @brief Call this as the condition of the measured loop.
+     * @return true as long as the benchmark should go on.
+     */
+    bool keepRunning() {
+        if (m_iterations == 0) {
+            m_start = clock::now();
+        }
+        if (m_fixedIterationCount > 0) {
+            if (m_iterations == m_fixedIterationCount) {
+                m_elapsed = clock::now() - m_start;
+                return false;
+            }
+            m_iterations++;
+            return true;
+        }
+        // Only look at the clock every now and then, it is not free
+        if ((m_iterations & (CLOCK_CHECK_INTERVAL - 1)) == 0 && m_iterations > 0 && clock::now() - m_start >= m_minTime) {
+            m_elapsed = clock::now() - m_start;
+            return false;
+        }
+        m_iterations++;
+        return true;
+    }
+
+    /**
+     * @brief Run exactly this many iterations instead of running until the minimum time has passed, e.g. to simulate a fixed number of
+     * steps of a scene, so every run does the same work.
+     * @param i_iterationCount The number of iterations, 0 to go back to the minimum time.
+     */
+    void setIterationCount(std::uint64_t i_iterationCount) {
+        m_fixedIterationCount = i_iterationCount;
+    }
+
+    /**
+     * @brief Declare how many items (e.g. contacts) one iteration processes, to get the time per item in the report.
+     * @param i_itemsPerIteration The number of items.
+     */
+    void setItemsPerIteration(std::uint64_t i_itemsPerIteration) {
+        m_itemsPerIteration = i_itemsPerIteration;
+    }
+
+    /**
+     * @brief Add a custom value to the report, e.g. a memory footprint.
+     * @param i_name Name of the value.
+     * @param i_value The value.
+     */
+    void setCounter(const std::string & i_name, double i_value) {
+        m_counters.emplace_back(i_name, i_value);
+    }
+
+    std::uint64_t getIterations() const {
+        return m_iterations;
+    }
+
+    std::uint64_t getItemsPerIteration() const {
+        return m_itemsPerIteration;
+    }
+
+    double getNanosecondsPerIteration() const {
+        return m_iterations == 0 ? 0.0 : std::chrono::duration<double, std::nano>(m_elapsed).count() / m_iterations;
+    }
+
+    const std::vector<std::pair<std::string, double>> & getCounters() const {
+        return m_counters;
+    }
+
+  private:
+    using clock = std::chrono::steady_clock;
+    static constexpr std::uint64_t CLOCK_CHECK_INTERVAL = 64; // Must be a power of two
+
+    std::chrono::nanoseconds m_minTime;
+    clock::time_point m_start;
+    clock::duration m_elapsed = clock::duration::zero();
+    std::uint64_t m_iterations = 0;
+    std::uint64_t m_itemsPerIteration = 1;
+    std::uint64_t m_fixedIterationCount = 0;
+    std::vector<std::pair<std::string, double>> m_counters;
+};
+
+/**
+ * @brief A registered benchmark.
+ */
+struct benchmarkEntry {
+    std::string name;
+    std::function<void(benchmarkState &)> function;
+};
+
+/**
+ * @brief All benchmarks registered with REGISTER_BENCHMARK.
+ * @return The list of benchmarks.
+ */
+inline std::vector<benchmarkEntry> & getRegistry() {
+    static std::vector<benchmarkEntry> registry;
+    return registry;
+}
+
+/**
+ * @brief Adds a benchmark to the registry during static initialization.
+ */
+struct registrar {
+    registrar(const char * i_name, std::function<void(benchmarkState &)> i_function) {
+        getRegistry().push_back({i_name, i_function});
+    }
+};
+
+/**
+ * @brief Runs a function during static initialization which registers several benchmarks, e.g. one for every parameter. Use
+ * REGISTER_BENCHMARKS.
+ */
+struct registrationFunction {
+    explicit registrationFunction(void (*i_registerBenchmarks)()) {
+        i_registerBenchmarks();
+    }
+};
+
+/**
+ * @brief Add a benchmark which takes parameters besides the state, e.g. the body count of a scene. The parameters are copied into the
+ * registered benchmark.
+ * @param i_name Name of the benchmark.
+ * @param i_function Function taking a benchmarkState and the parameters.
+ * @param i_parameters The parameters of this benchmark.
+ */
+template <typename Function, typename... Parameters>
+void registerParameterized(const std::string & i_name, Function i_function, Parameters... i_parameters) {
+    getRegistry().push_back({i_name, [i_function, i_parameters...](benchmarkState & io_state) { i_function(io_state, i_parameters...); }});
+}
+
+/**
+ * @brief Prevent the compiler from optimizing away a computation whose result is otherwise unused.
+ * @param i_value The result.
+ */
+template <typename T> inline void doNotOptimize(const T & i_value) {
+#if defined(_MSC_VER)
+    // MSVC has no inline assembly on x64, a volatile read does the job
+    const volatile char * volatile sink = reinterpret_cast<const volatile char *>(&i_value);
+    (void)sink;
+#else
+    asm volatile("" : : "r,m"(i_value) : "memory");
+#endif
+}
+
+/**
+ * @brief A regular polygon, e.g. to compare shapes with different vertex counts.
+ * @param i_vertexCount Number of vertices.
+ * @param i_radius Distance from the center to the vertices in pixels.
+ * @return The shape definition.
+ */
+inline std::shared_ptr<const ShapeDefinition> createRegularPolygon(int i_vertexCount, float i_radius) {
+    std::vector<sf::Vector2f> vertices;
+    for (int i = 0; i < i_vertexCount; i++) {
+        vertices.push_back(sfu::rotateVector(sf::Vector2f(i_radius, 0.0f), -360.0f / i_vertexCount * i));
+    }
+    return ShapeDefinition::createPolygon(vertices);
+}
+
+} // namespace bench
+
+#define BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_IMPL(a, b)
+
+/// Register a function `void name(bench::benchmarkState &)` as benchmark.
+#define REGISTER_BENCHMARK(function) static bench::registrar BENCHMARK_CONCAT(s_benchmarkRegistrar, __LINE__)(#function, function)
+
+/// Register a lambda or function object under a custom name, e.g. to run the same benchmark with different parameters.
+#define REGISTER_BENCHMARK_NAMED(name, function) static bench::registrar BENCHMARK_CONCAT(s_benchmarkRegistrar, __LINE__)(name, function)
+
+/// Run a function `void name()` during static initialization, which registers benchmarks with bench::registerParameterized.
+#define REGISTER_BENCHMARKS(function) static bench::registrationFunction BENCHMARK_CONCAT(s_benchmarkRegistrar, __LINE__)(function)
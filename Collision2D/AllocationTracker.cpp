@@ -0,0 +1,196 @@
+#include "AllocationTracker.hpp"
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+std::array<std::atomic<std::uint64_t>, AllocationTracker::SUBSYSTEM_COUNT> AllocationTracker::s_allocationCounts{};
+std::array<std::atomic<std::uint64_t>, AllocationTracker::SUBSYSTEM_COUNT> AllocationTracker::s_deallocationCounts{};
+std::array<std::atomic<std::size_t>, AllocationTracker::SUBSYSTEM_COUNT> AllocationTracker::s_liveBytes{};
+std::array<std::atomic<std::size_t>, AllocationTracker::SUBSYSTEM_COUNT> AllocationTracker::s_peakBytes{};
+thread_local memorySubsystem AllocationTracker::s_currentSubsystem = memorySubsystem::other;
+
+/**
+ * @brief The heap memory of a subsystem.
+ * @param i_subsystem The subsystem.
+ * @return The counters, all zero if COLLISION2D_TRACK_ALLOCATIONS isn't defined.
+ */
+subsystemMemory AllocationTracker::getMemory(memorySubsystem i_subsystem) {
+    std::size_t index = static_cast<std::size_t>(i_subsystem);
+    subsystemMemory memory;
+    memory.allocationCount = s_allocationCounts[index].load(std::memory_order_relaxed);
+    memory.deallocationCount = s_deallocationCounts[index].load(std::memory_order_relaxed);
+    memory.liveBytes = s_liveBytes[index].load(std::memory_order_relaxed);
+    memory.peakBytes = s_peakBytes[index].load(std::memory_order_relaxed);
+    return memory;
+}
+
+/**
+ * @brief The number of allocations of all subsystems, e.g. to count the allocations of a step.
+ * @return The allocation count since the start of the program.
+ */
+std::uint64_t AllocationTracker::getAllocationCount() {
+    std::uint64_t allocationCount = 0;
+    for (const std::atomic<std::uint64_t> & count : s_allocationCounts) {
+        allocationCount += count.load(std::memory_order_relaxed);
+    }
+    return allocationCount;
+}
+
+/**
+ * @brief The heap memory in use by all subsystems.
+ * @return The live bytes, not counting the bookkeeping of the tracker and the allocator.
+ */
+std::size_t AllocationTracker::getLiveBytes() {
+    std::size_t liveBytes = 0;
+    for (const std::atomic<std::size_t> & bytes : s_liveBytes) {
+        liveBytes += bytes.load(std::memory_order_relaxed);
+    }
+    return liveBytes;
+}
+
+/**
+ * @brief The largest amount of physical memory the process has used so far. Works without COLLISION2D_TRACK_ALLOCATIONS.
+ * @return The peak resident set size (peak working set on Windows) in bytes, 0 if the platform doesn't report it.
+ */
+std::size_t AllocationTracker::getPeakResidentBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(__APPLE__)
+    return static_cast<std::size_t>(usage.ru_maxrss); // In bytes
+#else
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024; // In kilobytes
+#endif
+#endif
+}
+
+/**
+ * @brief A readable name of a subsystem, e.g. for reports.
+ * @param i_subsystem The subsystem.
+ * @return The name.
+ */
+const char * AllocationTracker::getSubsystemName(memorySubsystem i_subsystem) {
+    switch (i_subsystem) {
+    case memorySubsystem::other:
+        return "other";
+    case memorySubsystem::bodies:
+        return "bodies";
+    case memorySubsystem::shapes:
+        return "shapes";
+    case memorySubsystem::broadphase:
+        return "broadphase";
+    case memorySubsystem::contacts:
+        return "contacts";
+    case memorySubsystem::rendering:
+        return "rendering";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief The subsystem new allocations of the calling thread are attributed to.
+ * @return The subsystem of the innermost MemoryScope, memorySubsystem::other outside of any scope.
+ */
+memorySubsystem AllocationTracker::getCurrentSubsystem() {
+    return s_currentSubsystem;
+}
+
+/**
+ * @brief Count an allocation. Called by the replaced operator new, or by a custom allocator.
+ * @param i_subsystem The subsystem the memory belongs to.
+ * @param i_size Size of the block in bytes.
+ */
+void AllocationTracker::recordAllocation(memorySubsystem i_subsystem, std::size_t i_size) {
+    std::size_t index = static_cast<std::size_t>(i_subsystem);
+    s_allocationCounts[index].fetch_add(1, std::memory_order_relaxed);
+    std::size_t liveBytes = s_liveBytes[index].fetch_add(i_size, std::memory_order_relaxed) + i_size;
+    std::size_t peakBytes = s_peakBytes[index].load(std::memory_order_relaxed);
+    while (liveBytes > peakBytes && !s_peakBytes[index].compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed)) {}
+}
+
+/**
+ * @brief Count a deallocation. Called by the replaced operator delete, or by a custom allocator.
+ * @param i_subsystem The subsystem which has allocated the memory.
+ * @param i_size Size of the block in bytes.
+ */
+void AllocationTracker::recordDeallocation(memorySubsystem i_subsystem, std::size_t i_size) {
+    std::size_t index = static_cast<std::size_t>(i_subsystem);
+    s_deallocationCounts[index].fetch_add(1, std::memory_order_relaxed);
+    s_liveBytes[index].fetch_sub(i_size, std::memory_order_relaxed);
+}
+
+#ifdef COLLISION2D_TRACK_ALLOCATIONS
+namespace {
+/**
+ * @brief Stored in front of every block, so operator delete knows how much memory it frees and whom it belongs to. The size of the header
+ * keeps the block aligned like a block of malloc.
+ */
+struct alignas(alignof(std::max_align_t)) allocationHeader {
+    std::size_t size;
+    memorySubsystem subsystem;
+};
+
+void * allocateTracked(std::size_t i_size) {
+    void * block = std::malloc(sizeof(allocationHeader) + i_size);
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    allocationHeader * header = static_cast<allocationHeader *>(block);
+    header->size = i_size;
+    header->subsystem = AllocationTracker::getCurrentSubsystem();
+    AllocationTracker::recordAllocation(header->subsystem, i_size);
+    return header + 1;
+}
+
+void freeTracked(void * i_pointer) {
+    if (i_pointer == nullptr) {
+        return;
+    }
+    allocationHeader * header = static_cast<allocationHeader *>(i_pointer) - 1;
+    AllocationTracker::recordDeallocation(header->subsystem, header->size);
+    std::free(header);
+}
+} // namespace
+
+// The replaced global allocation functions. The nothrow and sized versions of the standard library forward to these.
+void * operator new(std::size_t i_size) {
+    return allocateTracked(i_size);
+}
+
+void * operator new[](std::size_t i_size) {
+    return allocateTracked(i_size);
+}
+
+void operator delete(void * i_pointer) noexcept {
+    freeTracked(i_pointer);
+}
+
+void operator delete[](void * i_pointer) noexcept {
+    freeTracked(i_pointer);
+}
+
+void operator delete(void * i_pointer, std::size_t) noexcept {
+    freeTracked(i_pointer);
+}
+
+void operator delete[](void * i_pointer, std::size_t) noexcept {
+    freeTracked(i_pointer);
+}
+#endif
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Define COLLISION2D_TRACK_ALLOCATIONS to replace the global operator new and delete with versions that count every heap allocation and
+// attribute it to the subsystem of the innermost COLLISION2D_MEMORY_SCOPE. Without it, the scopes compile to nothing and the counters stay
+// zero. Programs that replace the global allocation functions themselves (like the tests) must not define it, the tests_tracking project
+// tests the replaced functions instead.
+#ifdef COLLISION2D_TRACK_ALLOCATIONS
+#define COLLISION2D_MEMORY_SCOPE(i_subsystem) MemoryScope COLLISION2D_MEMORY_SCOPE_NAME(__LINE__)(i_subsystem)
+#else
+#define COLLISION2D_MEMORY_SCOPE(i_subsystem)
+#endif
+// Two levels, so __LINE__ is expanded before it is pasted
+#define COLLISION2D_MEMORY_SCOPE_NAME(i_line) COLLISION2D_MEMORY_CONCAT(memoryScope, i_line)
+#define COLLISION2D_MEMORY_CONCAT(i_first, i_second) i_first##i_second
+
+/**
+ * @brief The parts of the engine that heap allocations are attributed to.
+ */
+enum class memorySubsystem {
+    /// Allocations outside of any memory scope, e.g. by the application.
+    other,
+    /// Bodies and the BodyStore.
+    bodies,
+    /// Shape definitions with their vertices and normals.
+    shapes,
+    /// Candidate pairs and the frame arena.
+    broadphase,
+    /// Collision detection and the ContactSolver.
+    contacts,
+    /// Drawing the bodies and the overlays.
+    rendering
+};
+
+/**
+ * @brief Heap memory of one subsystem since the start of the program.
+ */
+struct subsystemMemory {
+    std::uint64_t allocationCount = 0;
+    std::uint64_t deallocationCount = 0;
+    /// Bytes allocated and not freed yet.
+    std::size_t liveBytes = 0;
+    /// Largest value liveBytes has had.
+    std::size_t peakBytes = 0;
+};
+
+/**
+ * @class AllocationTracker
+ * @brief Counts the heap allocations of the engine per subsystem, if COLLISION2D_TRACK_ALLOCATIONS is defined.
+ *
+ * The replaced operator new stores the size and the subsystem in front of every block, so a block is subtracted from the subsystem that
+ * allocated it, no matter which thread or scope frees it. Counting uses relaxed atomics and works from any thread.
+ */
+class AllocationTracker {
+  public:
+    // Getters
+    static subsystemMemory getMemory(memorySubsystem i_subsystem);
+    static std::uint64_t getAllocationCount();
+    static std::size_t getLiveBytes();
+    static std::size_t getPeakResidentBytes();
+    static const char * getSubsystemName(memorySubsystem i_subsystem);
+    static memorySubsystem getCurrentSubsystem();
+
+    // Public methods
+    static void recordAllocation(memorySubsystem i_subsystem, std::size_t i_size);
+    static void recordDeallocation(memorySubsystem i_subsystem, std::size_t i_size);
+
+    static constexpr std::size_t SUBSYSTEM_COUNT = static_cast<std::size_t>(memorySubsystem::rendering) + 1;
+#ifdef COLLISION2D_TRACK_ALLOCATIONS
+    static constexpr bool IS_ENABLED = true;
+#else
+    static constexpr bool IS_ENABLED = false;
+#endif
+
+  private:
+    friend class MemoryScope;
+
+    // Member variables
+    /// Counters of every subsystem. Zero-initialized before any allocation can happen, as they are static and constant-initialized.
+    static std::array<std::atomic<std::uint64_t>, SUBSYSTEM_COUNT> s_allocationCounts;
+    static std::array<std::atomic<std::uint64_t>, SUBSYSTEM_COUNT> s_deallocationCounts;
+    static std::array<std::atomic<std::size_t>, SUBSYSTEM_COUNT> s_liveBytes;
+    static std::array<std::atomic<std::size_t>, SUBSYSTEM_COUNT> s_peakBytes;
+    /// The subsystem new allocations of this thread are attributed to.
+    static thread_local memorySubsystem s_currentSubsystem;
+};
+
+/**
+ * @class MemoryScope
+ * @brief Attributes the allocations of the current thread to a subsystem until the end of the scope. Use COLLISION2D_MEMORY_SCOPE.
+ */
+class MemoryScope {
+  public:
+    explicit MemoryScope(memorySubsystem i_subsystem) : m_previousSubsystem(AllocationTracker::s_currentSubsystem) {
+        AllocationTracker::s_currentSubsystem = i_subsystem;
+    }
+    ~MemoryScope() {
+        AllocationTracker::s_currentSubsystem = m_previousSubsystem;
+    }
+
+  private:
+    MemoryScope(const MemoryScope &) = delete;
+    MemoryScope & operator=(const MemoryScope &) = delete;
+
+    memorySubsystem m_previousSubsystem;
+};
@@ -0,0 +1,37 @@
+#include "BodyRenderer.hpp"
+
+// Constructor. Sets the appearance shared by all bodies.
+BodyRenderer::BodyRenderer() {
+    m_shape.setOutlineColor(sf::Color::Red);
+    m_shape.setFillColor(sf::Color::Black);
+    m_shape.setOutlineThickness(-2.0f);
+}
+
+// Destructor
+BodyRenderer::~BodyRenderer() {}
+
+/**
+ * @brief Draw a body as a filled polygon.
+ * @param io_target The window or texture to draw to.
+ * @param i_body The body.
+ */
+void BodyRenderer::draw(sf::RenderTarget & io_target, const RigidBody & i_body) {
+    std::size_t pointCount = i_body.getPointCount();
+    m_shape.setPointCount(pointCount);
+    for (std::size_t i = 0; i < pointCount; i++) {
+        m_shape.setPoint(i, i_body.getPoint(i));
+    }
+    m_shape.setPosition(i_body.getPosition());
+    m_shape.setRotation(i_body.getRotation());
+    io_target.draw(m_shape);
+}
+
+/**
+ * @brief Draw a BoundaryElement as a line between its two vertices.
+ * @param io_target The window or texture to draw to.
+ * @param i_element The BoundaryElement.
+ */
+void BodyRenderer::drawBoundary(sf::RenderTarget & io_target, const BoundaryElement & i_element) {
+    sf::Vertex line[2] = {sf::Vertex(i_element.getGlobalPoint(0)), sf::Vertex(i_element.getGlobalPoint(1))};
+    io_target.draw(line, 2, sf::Lines);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "BoundaryElement.hpp"
+#include "RigidBody.hpp"
+#include <SFML/Graphics.hpp>
+
+/**
+ * @class BodyRenderer
+ * @brief Draws RigidBodies with SFML.
+ *
+ * The bodies don't know anything about rendering. Before drawing a body, its points and transform are copied into a single reused
+ * sf::ConvexShape, so the appearance (outline and fill color, outline thickness) is defined in one place instead of in every body.
+ */
+class BodyRenderer {
+  public:
+    // Constructor
+    BodyRenderer();
+
+    // Destructor
+    ~BodyRenderer();
+
+    // Public methods
+    void draw(sf::RenderTarget & io_target, const RigidBody & i_body);
+    void drawBoundary(sf::RenderTarget & io_target, const BoundaryElement & i_element);
+
+  private:
+    // Member variables
+    /// Takes on the shape of the body that is currently drawn.
+    sf::ConvexShape m_shape;
+};
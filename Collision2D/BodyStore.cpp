@@ -0,0 +1,350 @@
+#include "BodyStore.hpp"
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * @class BlockPool
+ * @brief Hands out memory blocks of a fixed size. Freed blocks are kept in a free list and reused, new blocks are carved from chunks which
+ * hold several blocks at once.
+ *
+ * Every block is aligned like regular heap memory, as long as the block size is a multiple of BodyStore::BLOCK_ALIGNMENT.
+ */
+class BlockPool {
+  public:
+    explicit BlockPool(std::size_t i_blockSize) : m_blockSize(i_blockSize) {}
+
+    std::size_t getBlockSize() const {
+        return m_blockSize;
+    }
+
+    void * allocate() {
+        if (m_reservedBlocks > 0) {
+            m_reservedBlocks--;
+        }
+        if (m_firstFreeBlock != nullptr) {
+            freeBlock * block = m_firstFreeBlock;
+            m_firstFreeBlock = block->next;
+            return block;
+        }
+        if (m_usedBlocksInChunk == m_blocksInChunk) {
+            addChunk(BLOCKS_PER_CHUNK);
+        }
+        return m_chunks.back().get() + m_blockSize * m_usedBlocksInChunk++;
+    }
+
+    /**
+     * @brief Make sure the next allocations don't need a new chunk. Reservations add up until the blocks have been allocated, so bodies of
+     * different types with the same block size can be reserved one after the other.
+     * @param i_count The number of blocks that will be allocated.
+     */
+    void reserve(std::size_t i_count) {
+        m_reservedBlocks += i_count;
+        std::size_t availableBlocks = m_blocksInChunk - m_usedBlocksInChunk;
+        for (freeBlock * block = m_firstFreeBlock; block != nullptr && availableBlocks < m_reservedBlocks; block = block->next) {
+            availableBlocks++;
+        }
+        if (availableBlocks < m_reservedBlocks) {
+            // The rest of the current chunk is lost, which is at most one chunk per reserve() call
+            addChunk(m_reservedBlocks - availableBlocks + (m_blocksInChunk - m_usedBlocksInChunk));
+        }
+    }
+
+    void free(void * i_block) {
+        freeBlock * block = static_cast<freeBlock *>(i_block);
+        block->next = m_firstFreeBlock;
+        m_firstFreeBlock = block;
+    }
+
+  private:
+    /// A free block stores the pointer to the next free block in its own memory.
+    struct freeBlock {
+        freeBlock * next;
+    };
+
+    void addChunk(std::size_t i_blockCount) {
+        m_chunks.emplace_back(new unsigned char[m_blockSize * i_blockCount]);
+        m_blocksInChunk = i_blockCount;
+        m_usedBlocksInChunk = 0;
+    }
+
+    std::size_t m_blockSize;
+    std::vector<std::unique_ptr<unsigned char[]>> m_chunks;
+    std::size_t m_blocksInChunk = 0;
+    std::size_t m_usedBlocksInChunk = 0;
+    /// Blocks which have been reserved, but not allocated yet.
+    std::size_t m_reservedBlocks = 0;
+    freeBlock * m_firstFreeBlock = nullptr;
+
+    static constexpr std::size_t BLOCKS_PER_CHUNK = 64;
+};
+
+// Constructor.
+BodyStore::BodyStore() : m_firstFreeSlot(NO_FREE_SLOT) {}
+
+// Destructor. Destroys all bodies that are still in the store.
+BodyStore::~BodyStore() {
+    clear();
+}
+
+/**
+ * @brief The number of bodies in the store.
+ * @return The body count.
+ */
+std::size_t BodyStore::size() const {
+    return m_bodies.size();
+}
+
+/**
+ * @brief All bodies in the store, stored contiguously for fast iteration. The order changes whenever a body is removed.
+ * @return The bodies.
+ */
+const std::vector<RigidBody *> & BodyStore::getBodies() const {
+    return m_bodies;
+}
+
+/**
+ * @brief Look up a body.
+ * @param i_handle The handle of the body.
+ * @return The body, or nullptr if the handle is invalid or the body has been removed.
+ */
+RigidBody * BodyStore::get(bodyHandle i_handle) const {
+    if (!contains(i_handle)) {
+        return nullptr;
+    }
+    return m_slots[i_handle.index].body;
+}
+
+/**
+ * @brief Check if a handle refers to a body in the store.
+ * @param i_handle The handle.
+ * @return true if the body is still in the store.
+ */
+bool BodyStore::contains(bodyHandle i_handle) const {
+    return i_handle.index < m_slots.size() && m_slots[i_handle.index].generation == i_handle.generation;
+}
+
+/**
+ * @brief The handle of the body at a given position of getBodies().
+ * @param i_denseIndex The position in getBodies().
+ * @return The handle.
+ */
+bodyHandle BodyStore::getHandle(std::size_t i_denseIndex) const {
+    std::uint32_t slotIndex = m_denseSlots[i_denseIndex];
+    return bodyHandle{slotIndex, m_slots[slotIndex].generation};
+}
+
+/**
+ * @brief Take ownership of a body which has been allocated with new.
+ * @param i_body The body. It is deleted when it is removed from the store.
+ * @return The handle of the body.
+ */
+bodyHandle BodyStore::insert(RigidBody * i_body) {
+    return addBody(i_body, nullptr, -1);
+}
+
+/**
+ * @brief Remove a body from the store and destroy it. If changes are deferred, the body is only queued for removal.
+ * @param i_handle The handle of the body.
+ * @return false if the handle doesn't refer to a body in the store or the body is already queued for removal.
+ */
+bool BodyStore::remove(bodyHandle i_handle) {
+    if (!contains(i_handle) || m_slots[i_handle.index].isRemovalPending) {
+        return false;
+    }
+    if (m_isDeferringChanges) {
+        m_slots[i_handle.index].isRemovalPending = true;
+        m_pendingRemovals.push_back(i_handle.index);
+        return true;
+    }
+    destroyBody(i_handle.index);
+    return true;
+}
+
+/**
+ * @brief Remove a body from the store and destroy it. Prefer the handle based overload, which doesn't have to search for the body.
+ * @param i_body The body.
+ * @return false if the body is not in the store or is already queued for removal.
+ */
+bool BodyStore::remove(RigidBody * i_body) {
+    std::vector<RigidBody *>::iterator position = std::find(m_bodies.begin(), m_bodies.end(), i_body);
+    if (position != m_bodies.end()) {
+        return remove(getHandle(position - m_bodies.begin()));
+    }
+    for (std::uint32_t slotIndex : m_pendingAdditions) {
+        if (m_slots[slotIndex].body == i_body) {
+            return remove(bodyHandle{slotIndex, m_slots[slotIndex].generation});
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Destroy all bodies, including queued ones. Existing handles become invalid, the pooled memory is kept for new bodies.
+ */
+void BodyStore::clear() {
+    applyDeferredChanges();
+    while (!m_bodies.empty()) {
+        destroyBody(m_denseSlots.back());
+    }
+}
+
+/**
+ * @brief Queue all following additions and removals until applyDeferredChanges() is called. Use this while iterating over the bodies.
+ */
+void BodyStore::deferChanges() {
+    m_isDeferringChanges = true;
+}
+
+/**
+ * @brief Add the queued bodies to the dense array and destroy the bodies queued for removal, then stop deferring changes.
+ *
+ * Every removal is a swap and pop, so removing many bodies at once takes linear time in the number of removed bodies.
+ */
+void BodyStore::applyDeferredChanges() {
+    m_isDeferringChanges = false;
+    // Additions first, so bodies which have been added and removed in the same step are in the dense array when they are destroyed
+    for (std::uint32_t slotIndex : m_pendingAdditions) {
+        appendToDenseArray(slotIndex);
+    }
+    m_pendingAdditions.clear();
+    for (std::uint32_t slotIndex : m_pendingRemovals) {
+        destroyBody(slotIndex);
+    }
+    m_pendingRemovals.clear();
+}
+
+/**
+ * @brief Put a body into a free slot and append it to the dense array.
+ * @param i_body The body.
+ * @param i_block The pooled memory of the body, or nullptr if it has been allocated with new.
+ * @param i_poolIndex The pool i_block belongs to.
+ * @return The handle of the body.
+ */
+bodyHandle BodyStore::addBody(RigidBody * i_body, void * i_block, int i_poolIndex) {
+    if (m_reservedSlotCount > 0) {
+        m_reservedSlotCount--;
+    }
+    std::uint32_t slotIndex = m_firstFreeSlot;
+    if (slotIndex == NO_FREE_SLOT) {
+        slotIndex = static_cast<std::uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    } else {
+        m_firstFreeSlot = m_slots[slotIndex].denseIndexOrNextFree;
+    }
+    bodySlot & slot = m_slots[slotIndex];
+    slot.block = i_block;
+    slot.poolIndex = i_poolIndex;
+    slot.body = i_body;
+    if (m_isDeferringChanges) {
+        slot.denseIndexOrNextFree = PENDING_DENSE_INDEX;
+        m_pendingAdditions.push_back(slotIndex);
+    } else {
+        appendToDenseArray(slotIndex);
+    }
+    return bodyHandle{slotIndex, slot.generation};
+}
+
+/**
+ * @brief Append the body of a slot to the dense array.
+ * @param i_slotIndex The slot of the body.
+ */
+void BodyStore::appendToDenseArray(std::uint32_t i_slotIndex) {
+    m_slots[i_slotIndex].denseIndexOrNextFree = static_cast<std::uint32_t>(m_bodies.size());
+    m_bodies.push_back(m_slots[i_slotIndex].body);
+    m_denseSlots.push_back(i_slotIndex);
+}
+
+/**
+ * @brief Destroy the body of a slot, fill its gap in the dense array with the last body and put the slot on the free list.
+ * @param i_slotIndex The slot of the body.
+ */
+void BodyStore::destroyBody(std::uint32_t i_slotIndex) {
+    bodySlot & slot = m_slots[i_slotIndex];
+    std::uint32_t denseIndex = slot.denseIndexOrNextFree;
+    RigidBody * body = slot.body;
+
+    // Swap and pop
+    m_bodies[denseIndex] = m_bodies.back();
+    m_denseSlots[denseIndex] = m_denseSlots.back();
+    m_slots[m_denseSlots[denseIndex]].denseIndexOrNextFree = denseIndex;
+    m_bodies.pop_back();
+    m_denseSlots.pop_back();
+
+    if (slot.block == nullptr) {
+        delete body;
+    } else {
+        body->~RigidBody();
+        freeBlock(slot.block, slot.poolIndex);
+    }
+    // Old handles to this slot become invalid
+    slot.generation++;
+    if (slot.generation == 0) {
+        slot.generation = 1; // Zero is reserved for handles which don't refer to any body
+    }
+    slot.block = nullptr;
+    slot.poolIndex = -1;
+    slot.body = nullptr;
+    slot.isRemovalPending = false;
+    slot.denseIndexOrNextFree = m_firstFreeSlot;
+    m_firstFreeSlot = i_slotIndex;
+}
+
+/**
+ * @brief Make room for more bodies in the dense arrays and the slots. Reservations add up until the bodies have been added, like the
+ * reservations of the pools.
+ * @param i_count The number of bodies to add.
+ */
+void BodyStore::reserveSlots(std::size_t i_count) {
+    m_reservedSlotCount += i_count;
+    std::size_t bodyCount = m_bodies.size() + m_pendingAdditions.size() + m_reservedSlotCount;
+    m_bodies.reserve(bodyCount);
+    m_denseSlots.reserve(bodyCount);
+    // Free slots are reused first, so every body needs one slot
+    m_slots.reserve(bodyCount);
+}
+
+/**
+ * @brief Make room for more bodies in the pool for the given size.
+ * @param i_size The size of the bodies in bytes.
+ * @param i_count The number of bodies to add.
+ */
+void BodyStore::reserveBlocks(std::size_t i_size, std::size_t i_count) {
+    m_pools[getPoolIndex(i_size)]->reserve(i_count);
+}
+
+/**
+ * @brief Find the pool for the given size, creating it if needed.
+ * @param i_size The size in bytes.
+ * @return The index of the pool.
+ */
+int BodyStore::getPoolIndex(std::size_t i_size) {
+    // Round up, so every block is aligned like regular heap memory
+    std::size_t blockSize = (i_size + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT;
+    for (std::size_t i = 0; i < m_pools.size(); i++) {
+        if (m_pools[i]->getBlockSize() == blockSize) {
+            return static_cast<int>(i);
+        }
+    }
+    m_pools.emplace_back(new BlockPool(blockSize));
+    return static_cast<int>(m_pools.size()) - 1;
+}
+
+/**
+ * @brief Get a memory block from the pool for the given size.
+ * @param i_size The size in bytes.
+ * @param o_poolIndex The index of the pool the block belongs to.
+ * @return The block.
+ */
+void * BodyStore::allocateBlock(std::size_t i_size, int & o_poolIndex) {
+    o_poolIndex = getPoolIndex(i_size);
+    return m_pools[o_poolIndex]->allocate();
+}
+
+/**
+ * @brief Give a memory block back to its pool.
+ * @param i_block The block.
+ * @param i_poolIndex The pool the block belongs to.
+ */
+void BodyStore::freeBlock(void * i_block, int i_poolIndex) {
+    m_pools[i_poolIndex]->free(i_block);
+}
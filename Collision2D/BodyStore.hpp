@@ -0,0 +1,160 @@
+#pragma once
+
+#include "RigidBody.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class BlockPool;
+
+/**
+ * @brief Refers to a body in a BodyStore.
+ *
+ * Unlike a pointer, a handle can be checked for validity: once the body has been removed, its slot gets a new generation and old handles to
+ * the slot are rejected.
+ */
+struct bodyHandle {
+    /// Index of the slot in the BodyStore.
+    std::uint32_t index = 0;
+    /// Generation of the slot at the time the handle was created. Zero for handles which don't refer to any body.
+    std::uint32_t generation = 0;
+
+    bool operator==(const bodyHandle & i_other) const {
+        return index == i_other.index && generation == i_other.generation;
+    }
+    bool operator!=(const bodyHandle & i_other) const {
+        return !(*this == i_other);
+    }
+};
+
+/**
+ * @class BodyStore
+ * @brief Owns the simulated bodies and hands out generational handles to them.
+ *
+ * Bodies are kept in a dense array for fast iteration. Creating and removing a body takes constant time: free slots are kept in a free
+ * list, and a removed body is replaced by the last body of the dense array (so the order of the bodies changes). Bodies created with
+ * create() are placed in pooled memory blocks, which are reused for later bodies of a similar size instead of going back to the heap.
+ *
+ * While the bodies are being iterated (e.g. during a time step), call deferChanges(): new and removed bodies are then queued and only
+ * added to or taken out of the dense array by applyDeferredChanges(), so getBodies() stays unchanged. Handles of queued bodies are valid
+ * right away, and bodies queued for removal stay accessible until the changes are applied.
+ */
+class BodyStore {
+  public:
+    // Constructor
+    BodyStore();
+
+    // Destructor
+    ~BodyStore();
+
+    // Getters
+    std::size_t size() const;
+    const std::vector<RigidBody *> & getBodies() const;
+    RigidBody * get(bodyHandle i_handle) const;
+    bool contains(bodyHandle i_handle) const;
+    bodyHandle getHandle(std::size_t i_denseIndex) const;
+
+    // Public methods
+    bodyHandle insert(RigidBody * i_body);
+    template <typename T, typename... Args> bodyHandle create(Args &&... i_args);
+    template <typename T> void reserve(std::size_t i_count);
+    bool remove(bodyHandle i_handle);
+    bool remove(RigidBody * i_body);
+    void clear();
+    void deferChanges();
+    void applyDeferredChanges();
+
+    /// Alignment of pooled bodies in bytes, the same as for regular heap memory. Bodies are packed densely, without padding to cache lines.
+    static constexpr std::size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+
+  private:
+    /**
+     * @brief Bookkeeping for one handle index.
+     */
+    struct bodySlot {
+        /// Incremented every time the body in the slot is removed.
+        std::uint32_t generation = 1;
+        /// Position of the body in m_bodies, or the next free slot if the slot is free.
+        std::uint32_t denseIndexOrNextFree = 0;
+        /// The memory of the body, or nullptr if the body has been allocated with new.
+        void * block = nullptr;
+        /// The pool the block belongs to.
+        int poolIndex = -1;
+        /// The body in the slot, or nullptr if the slot is free.
+        RigidBody * body = nullptr;
+        /// Set while the body is queued for removal, so it is only destroyed once.
+        bool isRemovalPending = false;
+    };
+
+    // Deleted copy constructor and assignment operator
+    BodyStore(const BodyStore &) = delete;
+    BodyStore & operator=(const BodyStore &) = delete;
+
+    // Private methods
+    bodyHandle addBody(RigidBody * i_body, void * i_block, int i_poolIndex);
+    void appendToDenseArray(std::uint32_t i_slotIndex);
+    void destroyBody(std::uint32_t i_slotIndex);
+    void reserveSlots(std::size_t i_count);
+    void reserveBlocks(std::size_t i_size, std::size_t i_count);
+    int getPoolIndex(std::size_t i_size);
+    void * allocateBlock(std::size_t i_size, int & o_poolIndex);
+    void freeBlock(void * i_block, int i_poolIndex);
+
+    // Member variables
+    /// The bodies in no particular order.
+    std::vector<RigidBody *> m_bodies;
+    /// The slot of every body in m_bodies.
+    std::vector<std::uint32_t> m_denseSlots;
+    std::vector<bodySlot> m_slots;
+    /// First slot of the free list, or NO_FREE_SLOT.
+    std::uint32_t m_firstFreeSlot;
+    /// One pool per block size.
+    std::vector<std::unique_ptr<BlockPool>> m_pools;
+    /// Bodies which have been reserved, but not added yet.
+    std::size_t m_reservedSlotCount = 0;
+    /// If set, additions and removals are queued until applyDeferredChanges() is called.
+    bool m_isDeferringChanges = false;
+    /// Slots of bodies which have been added while changes were deferred.
+    std::vector<std::uint32_t> m_pendingAdditions;
+    /// Slots of bodies which have been removed while changes were deferred.
+    std::vector<std::uint32_t> m_pendingRemovals;
+
+    static constexpr std::uint32_t NO_FREE_SLOT = 0xFFFFFFFF;
+    /// Dense index of bodies which have been added while changes were deferred.
+    static constexpr std::uint32_t PENDING_DENSE_INDEX = 0xFFFFFFFE;
+};
+
+/**
+ * @brief Construct a new body in pooled memory and take ownership of it.
+ * @tparam T The type of the body, e.g. Polygon or Circle.
+ * @param i_args Arguments passed to the constructor of T.
+ * @return The handle of the new body.
+ */
+template <typename T, typename... Args> bodyHandle BodyStore::create(Args &&... i_args) {
+    static_assert(std::is_base_of<RigidBody, T>::value, "BodyStore can only hold RigidBodies");
+    static_assert(alignof(T) <= BLOCK_ALIGNMENT, "Pooled blocks are only aligned to BLOCK_ALIGNMENT");
+    int poolIndex = -1;
+    void * block = allocateBlock(sizeof(T), poolIndex);
+    T * body = nullptr;
+    try {
+        body = new (block) T(std::forward<Args>(i_args)...);
+    } catch (...) {
+        freeBlock(block, poolIndex);
+        throw;
+    }
+    return addBody(body, block, poolIndex);
+}
+
+/**
+ * @brief Make room for more bodies of a type, so creating them doesn't allocate anything. Use this before creating a lot of bodies at once.
+ * @tparam T The type of the bodies.
+ * @param i_count The number of bodies to add.
+ */
+template <typename T> void BodyStore::reserve(std::size_t i_count) {
+    reserveSlots(i_count);
+    reserveBlocks(sizeof(T), i_count);
+}
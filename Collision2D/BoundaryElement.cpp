@@ -3,16 +3,10 @@
 #include <iostream>
 
 BoundaryElement::BoundaryElement(float i_length)
-    : m_length(i_length), VertexBasedBody(0.0f, {sf::Vector2f(-i_length / 2, 0.0f), sf::Vector2f(i_length / 2, 0.0f)}) {}
+    : m_length(i_length), VertexBasedBody(0.0f, ShapeDefinition::createSegment(i_length)) {}
 
 BoundaryElement::~BoundaryElement() {}
 
-sf::Vertex * BoundaryElement::getVertexArray() {
-    m_vertexArray[0] = sf::Vertex(getGlobalPoint(0));
-    m_vertexArray[1] = sf::Vertex(getGlobalPoint(1));
-    return m_vertexArray;
-}
-
 /**
  * @brief Calculates the separation of any point to the center of the BoundaryElement. This is used to check if a calculated collision point
  * is actually inside the BoundaryElement.
@@ -33,12 +27,3 @@ pointSeparationData_type BoundaryElement::calculateMinPointSeparation(sf::Vector
 
     return separationData;
 }
-
-size_t BoundaryElement::getNormalCount() {
-    // There is only one normal vector
-    return 1;
-}
-
-sf::Vector2f BoundaryElement::getNormal(int i_index) {
-    return sf::Vector2f({0.0f,1.0f});
-}
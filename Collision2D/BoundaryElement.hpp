@@ -25,14 +25,9 @@ class BoundaryElement : public VertexBasedBody {
     ~BoundaryElement();
 
     // Public methods
-    sf::Vertex * getVertexArray();
     pointSeparationData_type calculateMinPointSeparation(sf::Vector2f i_point) override;
-    size_t getNormalCount() override;
 
   private:
-    sf::Vector2f getNormal(int i_index) override;
-    /// Array containing start and end point in body coordinates
-    sf::Vertex m_vertexArray[2];
     /// Length of the element in pixels
     float m_length;
 };
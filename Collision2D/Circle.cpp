@@ -1,69 +1,29 @@
 #include "Circle.hpp"
-#include "sfml_utility.hpp"
 
 /**
- * @brief Constructor.
+ * @brief Constructor. Creates a new shape definition, use the other constructor to share the geometry between many circles.
  *
  * @param i_inverseMass Inverse mass. Put in zero for an immovable body.
  * @param i_radius Radius in pixels.
  * @param i_resolution The amount of rendered vertices. Irrelevant for physics.
  */
 Circle::Circle(float i_inverseMass, float i_radius, int i_resolution)
-    : m_radius(i_radius), m_resolution(i_resolution), RigidBody(i_inverseMass) {
-    calculateAndSetArea();
-    calculatePoints(); // Determine the shape for rendering
-    setOrigin(sf::Vector2f(0.0f, 0.0f)); // Origin is always at the center point
-    m_inverseMomentOfInertia = calculateInverseMomentOfInertia();
-}
-
-Circle::~Circle() {}
-
-float Circle::getRadius() const {
-    return m_radius;
-}
-
-/**
- * @brief Calculate the covered area of the body based on the specified radius and set the m_area member variable.
- */
-void Circle::calculateAndSetArea() {
-    m_area = sfu::PI * m_radius * m_radius;
-}
-
-/**
- * @brief Calculate the inverse moment of inertia of the body based on the specified radius.
- * @return The inverse moment of inertia in 1/(mass unit * pixel^2)
- */
-float Circle::calculateInverseMomentOfInertia() {
-    return 2 * m_inverseMass * 1 / (m_radius * m_radius);
-}
+    : RigidBody(i_inverseMass, ShapeDefinition::createCircle(i_radius, i_resolution)) {}
 
 /**
- * @brief The center of mass of the Circle is always in the middle.
- * @return {0.0f,0.0f}
+ * @brief Constructor.
+ *
+ * @param i_inverseMass Inverse mass. Put in zero for an immovable body.
+ * @param i_shape A shape definition created with ShapeDefinition::createCircle().
  */
-sf::Vector2f Circle::calculateCenterOfMass() {
-    return sf::Vector2f(0.0f, 0.0f);
-}
+Circle::Circle(float i_inverseMass, std::shared_ptr<const ShapeDefinition> i_shape) : RigidBody(i_inverseMass, std::move(i_shape)) {}
 
-/**
- * @brief Calculates the coordinates of the points needed for rendering and writes them to m_points (they depend on radius and resolution).
- */
-void Circle::calculatePoints() {
-    float angle = 0.0f;
-    for (int i = 0; i < m_resolution; i++) {
-        // Go along the circle's border and calculate the points
-        sf::Vector2f newPoint = calculatePoint(angle);
-        m_points.push_back(newPoint);
-        // Angle increment depends on resolution
-        angle += 2 * sfu::PI / m_resolution;
-    }
-}
+Circle::~Circle() {}
 
 /**
- * @brief Calculates the points needed for rendering and writes them to m_points (they depend on radius an friction).
+ * @brief The radius of the circle, which is the same as its bounding radius.
+ * @return The radius in pixels.
  */
-sf::Vector2f Circle::calculatePoint(float angle) const {
-    // Calculate the coordinates of a point along the circle with the given angle.
-    sf::Vector2f newPoint = sf::Vector2f(cos(angle), sin(angle));
-    return sfu::scaleVector(newPoint, m_radius);
+float Circle::getRadius() const {
+    return m_state.boundingRadius;
 }
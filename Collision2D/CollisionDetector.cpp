@@ -1,5 +1,4 @@
 #include "CollisionDetector.hpp"
-#include <iostream>
 #include <array>
 #include <algorithm>
 #include <vector>
@@ -8,6 +7,76 @@
 std::unique_ptr<CollisionDetector> CollisionDetector::s_instance = nullptr;
 std::mutex CollisionDetector::mtx;
 
+namespace {
+/**
+ * @brief A body reduced to a convex core (the vertices of a VertexBasedBody or the center of a Circle) and a radius around the core.
+ */
+struct convexCore {
+    VertexBasedBody * vertexBasedBody = nullptr;
+    Circle * circle = nullptr;
+    int pointCount = 0;
+    int edgeCount = 0;
+    float radius = 0.0f;
+
+    explicit convexCore(RigidBody * i_body) {
+        vertexBasedBody = dynamic_cast<VertexBasedBody *>(i_body);
+        if (vertexBasedBody != nullptr) {
+            pointCount = static_cast<int>(vertexBasedBody->getPointCount());
+            edgeCount = static_cast<int>(vertexBasedBody->getNormalCount());
+        } else {
+            circle = dynamic_cast<Circle *>(i_body);
+            pointCount = 1;
+            radius = circle->getRadius();
+        }
+    }
+
+    // In global coordinates
+    sf::Vector2f getPoint(int i_index) const {
+        return vertexBasedBody != nullptr ? vertexBasedBody->getGlobalPoint(i_index) : circle->getPosition();
+    }
+};
+
+/**
+ * @brief Find the point of a line segment which is closest to a given point.
+ * @param i_point The point.
+ * @param i_start Start of the segment.
+ * @param i_end End of the segment.
+ * @return The closest point on the segment.
+ */
+sf::Vector2f closestPointOnSegment(sf::Vector2f i_point, sf::Vector2f i_start, sf::Vector2f i_end) {
+    sf::Vector2f segment = sfu::subtractVectors(i_end, i_start);
+    float segmentLengthSquared = sfu::scalarProduct(segment, segment);
+    if (segmentLengthSquared == 0.0f) {
+        return i_start;
+    }
+    float t = sfu::scalarProduct(sfu::subtractVectors(i_point, i_start), segment) / segmentLengthSquared;
+    t = std::max(0.0f, std::min(1.0f, t));
+    return sfu::addVectors(i_start, sfu::scaleVector(segment, t));
+}
+
+/**
+ * @brief Check the distance of every point of one core to every edge of the other core and keep the closest pair.
+ * @param i_points The core whose points are checked.
+ * @param i_edges The core whose edges are checked.
+ * @param i_pointsAreFirst true if i_points belongs to the first body of io_distance.
+ * @param io_distance The closest points found so far (distance between the cores, radii are not included yet).
+ */
+void findClosestPointToEdges(const convexCore & i_points, const convexCore & i_edges, bool i_pointsAreFirst, bodyDistance & io_distance) {
+    for (int i = 0; i < i_points.pointCount; i++) {
+        sf::Vector2f point = i_points.getPoint(i);
+        for (int j = 0; j < i_edges.edgeCount; j++) {
+            sf::Vector2f closestPoint = closestPointOnSegment(point, i_edges.getPoint(j), i_edges.getPoint((j + 1) % i_edges.pointCount));
+            float distance = sfu::getVectorLength(sfu::subtractVectors(closestPoint, point));
+            if (distance < io_distance.distance) {
+                io_distance.distance = distance;
+                io_distance.firstPoint = i_pointsAreFirst ? point : closestPoint;
+                io_distance.secondPoint = i_pointsAreFirst ? closestPoint : point;
+            }
+        }
+    }
+}
+} // namespace
+
 /**
  * @brief This method is called if an edge-on-edge-Collision is detected.
  * @param i_sepData1 Holds the indices of the two points making up the colliding edge of the first body.
@@ -197,8 +266,24 @@ CollisionDetector::CollisionDetector() {}
 // Destructor.
 CollisionDetector::~CollisionDetector() {}
 
+/**
+ * @brief The work done since the last resetCounters() call, e.g. to relate the time of the narrowphase to the composition of the scene.
+ * @return The counters.
+ */
+const narrowphaseCounters & CollisionDetector::getCounters() const {
+    return m_counters;
+}
+
+/**
+ * @brief Set all counters to zero, e.g. at the beginning of a step.
+ */
+void CollisionDetector::resetCounters() {
+    m_counters = narrowphaseCounters();
+}
+
 //  Detects a collision between two VertexBasedBodys and writes results to a collisionEvent
 CollisionEvent CollisionDetector::generateCollisionEvent(RigidBody * i_firstBody, RigidBody * i_secondBody) {
+    countCollisionCheck(i_firstBody->getShape().getType(), i_secondBody->getShape().getType());
     // Find out what the first body is
     collisionGeometry collisionGeometry;
 
@@ -222,6 +307,152 @@ CollisionEvent CollisionDetector::generateCollisionEvent(RigidBody * i_firstBody
     return CollisionEvent(i_firstBody, i_secondBody, collisionGeometry);
 }
 
+/**
+ * @brief Like generateCollisionEvent(), but also generates a speculative contact for bodies which don't touch yet.
+ *
+ * If the bodies are separated, but approach each other fast enough to close the gap within the time step, a speculative contact is
+ * returned (see CollisionEvent::isSpeculative()). Resolving it removes only the part of the closing speed that would make the bodies
+ * overlap, so fast bodies can't tunnel through thin ones without any substeps.
+ *
+ * @param i_firstBody One of the bodies.
+ * @param i_secondBody The other body.
+ * @param i_dT The time step in seconds.
+ * @return The CollisionEvent. Its separation is positive if there is neither a collision nor a speculative contact.
+ */
+CollisionEvent CollisionDetector::generateSpeculativeCollisionEvent(RigidBody * i_firstBody, RigidBody * i_secondBody, float i_dT) {
+    CollisionEvent collisionEvent = generateCollisionEvent(i_firstBody, i_secondBody);
+    if (collisionEvent.getMinSeparation() <= 0) {
+        return collisionEvent;
+    }
+    // Cheap check with bounding circles first, using an upper limit for the closing speed of any two points of the bodies
+    float maxClosingSpeed = sfu::getVectorLength(sfu::subtractVectors(i_firstBody->getVelocity(), i_secondBody->getVelocity())) +
+            std::fabs(i_firstBody->getAngularVelocityRadians()) * i_firstBody->getBoundingRadius() +
+            std::fabs(i_secondBody->getAngularVelocityRadians()) * i_secondBody->getBoundingRadius();
+    float centerDistance = sfu::getVectorLength(sfu::subtractVectors(i_secondBody->getPosition(), i_firstBody->getPosition()));
+    if (centerDistance - i_firstBody->getBoundingRadius() - i_secondBody->getBoundingRadius() > maxClosingSpeed * i_dT) {
+        return collisionEvent;
+    }
+    // The SAT separation is only a lower limit, the speculative contact needs the actual closest points
+    bodyDistance distance = calculateDistance(i_firstBody, i_secondBody);
+    if (distance.distance <= 0.0f) {
+        return collisionEvent;
+    }
+    CollisionEvent speculativeEvent(i_firstBody, i_secondBody, determineSeparatedGeometry(distance), i_dT);
+    if (speculativeEvent.getContactSpeed() * i_dT > distance.distance) {
+        return speculativeEvent;
+    }
+    return collisionEvent;
+}
+
+/**
+ * @brief Calculate the closest points of two bodies which don't overlap.
+ *
+ * Unlike the separation of the SAT algorithm, this is the actual distance, which makes it suitable for continuous collision detection.
+ *
+ * @param i_firstBody One of the bodies.
+ * @param i_secondBody The other body.
+ * @return The distance and the closest points. Only meaningful if the bodies don't overlap.
+ */
+bodyDistance CollisionDetector::calculateDistance(RigidBody * i_firstBody, RigidBody * i_secondBody) const {
+    convexCore firstCore(i_firstBody);
+    convexCore secondCore(i_secondBody);
+    bodyDistance result;
+    if (firstCore.edgeCount == 0 && secondCore.edgeCount == 0) {
+        // Two Circles
+        result.distance = sfu::getVectorLength(sfu::subtractVectors(secondCore.getPoint(0), firstCore.getPoint(0)));
+        result.firstPoint = firstCore.getPoint(0);
+        result.secondPoint = secondCore.getPoint(0);
+    } else {
+        // For convex bodies, one of the closest points is always a vertex (or the center of a Circle)
+        findClosestPointToEdges(firstCore, secondCore, true, result);
+        findClosestPointToEdges(secondCore, firstCore, false, result);
+    }
+
+    // Move the closest points from the cores to the surface of the bodies
+    sf::Vector2f direction = sfu::normalizeVector(sfu::subtractVectors(result.secondPoint, result.firstPoint));
+    result.firstPoint = sfu::addVectors(result.firstPoint, sfu::scaleVector(direction, firstCore.radius));
+    result.secondPoint = sfu::subtractVectors(result.secondPoint, sfu::scaleVector(direction, secondCore.radius));
+    result.distance = std::max(0.0f, result.distance - firstCore.radius - secondCore.radius);
+    return result;
+}
+
+/**
+ * @brief Find the time at which a moving body hits an obstacle, using conservative advancement.
+ *
+ * The moving body is advanced with its current velocity and angular velocity, the obstacle is assumed to rest. In each iteration, the
+ * body is moved ahead by the time it needs at least to cover the current distance, so it can never pass through the obstacle. If the
+ * iterations run out before the body is close enough, the impact is reported at the time reached so far. The body's position and rotation
+ * are restored afterwards.
+ *
+ * @param i_movingBody The moving body (e.g. a bullet).
+ * @param i_obstacle The obstacle.
+ * @param i_maxTime The time span to check in seconds.
+ * @return The time of impact and the contact geometry at that time, if the body hits the obstacle within i_maxTime. Bodies which already
+ * overlap are left to the discrete collision detection and never have an impact.
+ */
+impactData CollisionDetector::calculateTimeOfImpact(RigidBody * i_movingBody, RigidBody * i_obstacle, float i_maxTime) {
+    impactData impact;
+    sf::Vector2f velocity = i_movingBody->getVelocity();
+    float angularVelocity = i_movingBody->getAngularVelocityRadians();
+    // Upper limit for the speed of any point of the moving body
+    float maxSpeed = sfu::getVectorLength(velocity) + std::fabs(angularVelocity) * i_movingBody->getBoundingRadius();
+    // Cheap check with bounding circles first
+    float centerDistance = sfu::getVectorLength(sfu::subtractVectors(i_obstacle->getPosition(), i_movingBody->getPosition()));
+    if (maxSpeed <= 0.0f || centerDistance - i_movingBody->getBoundingRadius() - i_obstacle->getBoundingRadius() > maxSpeed * i_maxTime) {
+        return impact;
+    }
+    if (generateCollisionEvent(i_movingBody, i_obstacle).getMinSeparation() <= 0) {
+        return impact;
+    }
+
+    sf::Vector2f startPosition = i_movingBody->getPosition();
+    float startOrientation = i_movingBody->getOrientation();
+    float time = 0.0f;
+    for (int i = 0; i < MAX_TIME_OF_IMPACT_ITERATIONS; i++) {
+        bodyDistance distance = calculateDistance(i_movingBody, i_obstacle);
+        // If the advancement converges too slowly (e.g. for a fast spinning body), stop early rather than let the body pass through
+        if (distance.distance <= TIME_OF_IMPACT_TOLERANCE || i == MAX_TIME_OF_IMPACT_ITERATIONS - 1) {
+            sf::Vector2f normal = sfu::normalizeVector(sfu::subtractVectors(distance.secondPoint, distance.firstPoint));
+            // Local velocity of the moving body in the closest point
+            sf::Vector2f relativePosition = sfu::subtractVectors(distance.firstPoint, i_movingBody->getPosition());
+            sf::Vector2f pointVelocity = sfu::addVectors(velocity, sfu::pseudoCrossProduct(angularVelocity, relativePosition));
+            // A body which touches the obstacle but moves away (e.g. right after bouncing off) doesn't hit it
+            if (sfu::scalarProduct(pointVelocity, normal) > 0.0f) {
+                impact.hasImpact = true;
+                impact.time = time;
+                impact.geometry = determineSeparatedGeometry(distance);
+            }
+            break;
+        }
+        // The body can't get closer than this within the remaining time
+        time += (distance.distance - TIME_OF_IMPACT_TARGET_DISTANCE) / maxSpeed;
+        if (time >= i_maxTime) {
+            break;
+        }
+        i_movingBody->setPosition(sfu::addVectors(startPosition, sfu::scaleVector(velocity, time)));
+        i_movingBody->setOrientation(startOrientation + angularVelocity * time);
+    }
+
+    i_movingBody->setPosition(startPosition);
+    i_movingBody->setOrientation(startOrientation);
+    return impact;
+}
+
+/**
+ * @brief Determines the contact geometry of two bodies which don't touch yet.
+ * @param i_distance The closest points of the bodies, see calculateDistance().
+ * @return The contact geometry. The location is halfway between the closest points, normals[0] points from the first to the second body.
+ */
+collisionGeometry CollisionDetector::determineSeparatedGeometry(const bodyDistance & i_distance) const {
+    collisionGeometry collisionGeometry;
+    sf::Vector2f normal = sfu::normalizeVector(sfu::subtractVectors(i_distance.secondPoint, i_distance.firstPoint));
+    collisionGeometry.minSeparation = i_distance.distance;
+    collisionGeometry.location = sfu::scaleVector(sfu::addVectors(i_distance.firstPoint, i_distance.secondPoint), 0.5f);
+    collisionGeometry.normals[0] = normal;
+    collisionGeometry.normals[1] = sfu::scaleVector(normal, -1.0f);
+    return collisionGeometry;
+}
+
 VertexBasedBodySeparation CollisionDetector::evaluateEdge(VertexBasedBody & i_body1, VertexBasedBody & i_body2, int i_index) const {
     VertexBasedBodySeparation sepDataForEdge;
     int j = 0;
@@ -231,6 +462,7 @@ VertexBasedBodySeparation CollisionDetector::evaluateEdge(VertexBasedBody & i_bo
     sf::Vector2f normalVector = i_body1.getGlobalNormal(i_index);
     float minSep = std::numeric_limits<float>::max();
     while (j < body2PointCount) {
+        m_counters.projectedVertexCount++;
         // Calculate dot product for each normal and for each connecting line between vertices
         sf::Vector2f pointConnector = sf::Vector2f(i_body2.getGlobalPoint(j).x - i_body1.getGlobalPoint(i_index).x,
                 i_body2.getGlobalPoint(j).y - i_body1.getGlobalPoint(i_index).y);
@@ -272,6 +504,7 @@ VertexBasedBodySeparation CollisionDetector::calculateMinVertexBasedBodySeparati
     VertexBasedBodySeparation separationData;
 
     std::array<int, 2> indexArray2{-1, -1}; // Holds the point indices for the edge corresponding to the largest separation
+    m_counters.satAxisCount += i_body1.getNormalCount();
     // Loop through all vertices for Body1 and get normal vector
     for (int i = 0; i < i_body1.getNormalCount(); i++) {
         VertexBasedBodySeparation tempSeparationData = evaluateEdge(i_body1, i_body2, i);
@@ -296,6 +529,8 @@ VertexBasedBodySeparation CollisionDetector::calculateMinVertexBasedBodySeparati
 circleSeparation CollisionDetector::calculateMinCircleSeparation(VertexBasedBody & i_VertexBasedBody, Circle & i_circle) const {
     float radius = i_circle.getRadius();
     circleSeparation separationData;
+    m_counters.satAxisCount += i_VertexBasedBody.getNormalCount();
+    m_counters.projectedVertexCount += i_VertexBasedBody.getNormalCount();
 
     for (int i = 0; i < i_VertexBasedBody.getNormalCount(); i++) {
         // Iterate through all normals and determine the distance to the center point of the Circle
@@ -338,3 +573,22 @@ float CollisionDetector::computeMedian(const std::array<float, 4> & i_arr) {
     // Compute and return the median (average of the two middle elements)
     return (sortedArr[1] + sortedArr[2]) / 2.0f;
 }
+
+/**
+ * @brief Count a collision check by the shape types of the bodies.
+ * @param i_firstType The shape type of one body.
+ * @param i_secondType The shape type of the other body.
+ */
+void CollisionDetector::countCollisionCheck(shapeType i_firstType, shapeType i_secondType) {
+    bool hasSegment = i_firstType == shapeType::segment || i_secondType == shapeType::segment;
+    bool hasCircle = i_firstType == shapeType::circle || i_secondType == shapeType::circle;
+    if (hasSegment) {
+        (hasCircle ? m_counters.segmentCircleCount : m_counters.segmentPolygonCount)++;
+    } else if (i_firstType == shapeType::circle && i_secondType == shapeType::circle) {
+        m_counters.circleCircleCount++;
+    } else if (hasCircle) {
+        m_counters.polygonCircleCount++;
+    } else {
+        m_counters.polygonPolygonCount++;
+    }
+}
@@ -3,6 +3,7 @@
 #include "VertexBasedBody.hpp"
 #include "Circle.hpp"
 #include "CollisionEvent.hpp"
+#include "SimulationStats.hpp"
 #include <mutex>
 
 /**
@@ -39,6 +40,30 @@ struct circleSeparation {
     int normalIndex = -1;
 };
 
+/**
+ * @brief The closest points of two separated bodies.
+ */
+struct bodyDistance {
+    /// The distance in pixels. Zero if the bodies overlap.
+    float distance = std::numeric_limits<float>::max();
+    /// The point of the first body which is closest to the second body, in global coordinates.
+    sf::Vector2f firstPoint = sf::Vector2f();
+    /// The point of the second body which is closest to the first body, in global coordinates.
+    sf::Vector2f secondPoint = sf::Vector2f();
+};
+
+/**
+ * @brief Result of the continuous collision detection for a moving body.
+ */
+struct impactData {
+    /// Whether the body hits the obstacle within the given time.
+    bool hasImpact = false;
+    /// Time until the impact in seconds.
+    float time = 0.0f;
+    /// The contact at the time of impact. The separation is slightly positive, so it can't be confused with a discrete collision.
+    collisionGeometry geometry;
+};
+
 /**
  * @class CollisionDetector
  * @brief Singleton class that holds methods to detect Collisions between RigidBody objects and to determine the collision geometry.
@@ -51,8 +76,15 @@ class CollisionDetector {
     // Destructor
     ~CollisionDetector();
 
+    // Getters
+    const narrowphaseCounters & getCounters() const;
+
     // Public methods
     CollisionEvent generateCollisionEvent(RigidBody * i_firstBody, RigidBody * i_secondBody);
+    CollisionEvent generateSpeculativeCollisionEvent(RigidBody * i_firstBody, RigidBody * i_secondBody, float i_dT);
+    bodyDistance calculateDistance(RigidBody * i_firstBody, RigidBody * i_secondBody) const;
+    impactData calculateTimeOfImpact(RigidBody * i_movingBody, RigidBody * i_obstacle, float i_maxTime);
+    void resetCounters();
 
   private:
     // Singleton implementation
@@ -76,10 +108,20 @@ class CollisionDetector {
     collisionGeometry determineCollisionGeometry(Circle * i_firstBody, VertexBasedBody * i_secondBody);
     collisionGeometry determineCollisionGeometry(Circle * i_firstBody, Circle * i_secondBody);
     collisionGeometry determineVertexBodyAndCircleGeometry(VertexBasedBody * i_firstBody, Circle * i_secondBody);
+    collisionGeometry determineSeparatedGeometry(const bodyDistance & i_distance) const;
     float computeMedian(const std::array<float, 4> & i_arr);
+    void countCollisionCheck(shapeType i_firstType, shapeType i_secondType);
 
     // Private member variables
+    /// Work done since the last resetCounters(). Updated in the const SAT methods as well.
+    mutable narrowphaseCounters m_counters;
     /// The maximum angle of a collision to be considered edge-to-edge, in degrees
     const float MAX_ANGLE_FOR_EDGE_TO_EDGE = 1.0f;
     const float SEPARATION_TOLERANCE = 0.1f;
+    /// Continuous collision detection stops advancing a body once it is this close to the obstacle, in pixels.
+    const float TIME_OF_IMPACT_TOLERANCE = 0.5f;
+    /// Continuous collision detection aims for this distance, so it doesn't overshoot the tolerance, in pixels.
+    const float TIME_OF_IMPACT_TARGET_DISTANCE = 0.25f;
+    /// Conservative advancement usually converges within a few iterations, this is just a safeguard.
+    const int MAX_TIME_OF_IMPACT_ITERATIONS = 32;
 };
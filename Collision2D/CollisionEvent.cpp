@@ -1,57 +1,62 @@
 #include "CollisionEvent.hpp"
 #include "sfml_utility.hpp"
-#include <iostream>
 
 const int BODIES_PER_COLLISION = 2;
 
-// Constructor
-CollisionEvent::CollisionEvent(RigidBody * i_rb1, RigidBody * i_rb2, const collisionGeometry & i_cg)
-    : m_collisionPartners{i_rb1, i_rb2}, m_collisionGeometry(i_cg) {}
+/**
+ * @brief Constructor.
+ * @param i_rb1 The first collision partner.
+ * @param i_rb2 The second collision partner.
+ * @param i_cg The collision geometry.
+ * @param i_speculativeTimeStep If the bodies don't touch yet, the time step in seconds within which they are expected to touch. Zero for
+ * regular contacts.
+ */
+CollisionEvent::CollisionEvent(RigidBody * i_rb1, RigidBody * i_rb2, const collisionGeometry & i_cg, float i_speculativeTimeStep)
+    : m_collisionPartners{i_rb1, i_rb2}, m_collisionGeometry(i_cg), m_speculativeTimeStep(i_speculativeTimeStep) {}
 
 CollisionEvent::~CollisionEvent() {}
 
 /**
  * @brief Resolve the collision and apply the translational and rotational velocities to the respective bodies.
+ *
+ * A speculative contact only removes as much of the closing speed as is needed for the bodies to just touch at the end of the time step.
+ * It doesn't bounce, the restitution is applied once the bodies actually touch.
+ *
+ * @return resolveResult::degenerate if no impulse can be computed, e.g. because two static bodies have collided. The bodies are left
+ * unchanged in this case.
  */
-void CollisionEvent::resolve() {
-    float contactTransformationAngle = sfu::getVectorDirection(m_collisionGeometry.normals[0]); // only one is needed;
-
+resolveResult CollisionEvent::resolve() {
     // Get relative collision location in global coordinates for body 1 and 2
     std::array<sf::Vector2f, 2> relativePositions = {
             computeRelativePosition(m_collisionGeometry.location, m_collisionPartners[0]->getPosition()),
             computeRelativePosition(m_collisionGeometry.location, m_collisionPartners[1]->getPosition())};
 
     float contactSpeed = calculateContactSpeed(relativePositions);
+    float allowedContactSpeed = getAllowedContactSpeed();
 
     // Check contact speed to avoid bodies getting stuck inside each other
-    if (contactSpeed > 0) { 
-        // Restitution coefficient determines how much bodies will "bounce back"
-        float restitutionCoefficient =
-                m_collisionPartners[0]->getRestitutionCoefficient() * m_collisionPartners[1]->getRestitutionCoefficient();
-        float desiredDeltaVel = -contactSpeed * (1 + restitutionCoefficient);
-
-        float deltaVelPerUnitImpulse = 1.0f; // arbitrary value !=0
-
-        try {
-            deltaVelPerUnitImpulse = calculateDeltaVelPerUnitImpulse(relativePositions); // throws error if two bodies with infinite mass collide
-        } catch (const std::runtime_error & e) {
-            std::cerr << e.what() << "-> Forcing the bodies away from each other." << "\n";
-            for (RigidBody * colPar : m_collisionPartners) {
-                sf::Vector2f vel = colPar->getVelocity();
-                float angVel = colPar->getAngularVelocity();
-                sf::Vector2f newVel = sfu::scaleVector(vel, -1.0f);
-                float newAngVel = -1.0f;
-                colPar->setVelocity(newVel);
-                colPar->setAngularVelocity(newAngVel);
-            }
-        }
-        // Calculate and handle impulse vector
-        float impulseContactX = desiredDeltaVel / deltaVelPerUnitImpulse;
-        handleImpulse(relativePositions, impulseContactX, contactTransformationAngle);
+    if (contactSpeed <= allowedContactSpeed) {
+        return resolveResult::separating;
+    }
+    float deltaVelPerUnitImpulse = calculateDeltaVelPerUnitImpulse(relativePositions);
+    if (deltaVelPerUnitImpulse <= 0) {
+        // This would mean infinite inertia, there is no impulse that could change anything
+        return resolveResult::degenerate;
     }
+    // Restitution coefficient determines how much bodies will "bounce back"
+    float restitutionCoefficient = 0.0f;
+    if (!isSpeculative()) {
+        restitutionCoefficient = m_collisionPartners[0]->getRestitutionCoefficient() * m_collisionPartners[1]->getRestitutionCoefficient();
+    }
+    float desiredDeltaVel = allowedContactSpeed - contactSpeed * (1 + restitutionCoefficient);
+
+    // Calculate and handle impulse vector (frictionless, so there is no tangential component)
+    sf::Vector2f impulseContact = sf::Vector2f(desiredDeltaVel / deltaVelPerUnitImpulse, 0.0f);
+    handleImpulse(relativePositions, impulseContact);
+    return resolveResult::resolved;
 }
 
-collisionGeometry CollisionEvent::getCollisionGeometry() const {
+const collisionGeometry & CollisionEvent::getCollisionGeometry() const {
     return m_collisionGeometry;
 }
 
@@ -59,6 +64,41 @@ float CollisionEvent::getMinSeparation() const {
     return m_collisionGeometry.minSeparation;
 }
 
+std::array<RigidBody *, 2> CollisionEvent::getCollisionPartners() const {
+    return m_collisionPartners;
+}
+
+/**
+ * @brief Whether this is a speculative contact, i.e. the bodies don't touch yet but would touch within the time step.
+ * @return true for speculative contacts.
+ */
+bool CollisionEvent::isSpeculative() const {
+    return m_speculativeTimeStep > 0.0f && m_collisionGeometry.minSeparation > 0.0f;
+}
+
+/**
+ * @brief The speed at which the bodies currently approach each other in the contact point.
+ * @return The contact speed in pixels per second, positive if the bodies are approaching.
+ */
+float CollisionEvent::getContactSpeed() const {
+    std::array<sf::Vector2f, 2> relativePositions = {
+            sfu::subtractVectors(m_collisionGeometry.location, m_collisionPartners[0]->getPosition()),
+            sfu::subtractVectors(m_collisionGeometry.location, m_collisionPartners[1]->getPosition())};
+    return calculateContactSpeed(relativePositions);
+}
+
+/**
+ * @brief The contact speed that doesn't need to be resolved. For a speculative contact, this is the speed at which the bodies just close
+ * the gap within the time step.
+ * @return The allowed contact speed in pixels per second. Zero for regular contacts.
+ */
+float CollisionEvent::getAllowedContactSpeed() const {
+    if (!isSpeculative()) {
+        return 0.0f;
+    }
+    return m_collisionGeometry.minSeparation / m_speculativeTimeStep;
+}
+
 /**
  * @brief Calculates the relative position of the collision location to the body location.
  * @param i_collLoc The collision location in global coordinates.
@@ -79,7 +119,7 @@ sf::Vector2f CollisionEvent::computeRelativePosition(sf::Vector2f i_collLoc, sf:
 float CollisionEvent::calculateContactSpeed(std::array<sf::Vector2f, 2> i_relativePositions) const {
     float projectedClosingSpeed = 0.0f;
     for (int i = 0; i < BODIES_PER_COLLISION; i++) {
-        float angVel = m_collisionPartners[i]->getAngularVelocity() * sfu::PI / 180; // in rad/s
+        float angVel = m_collisionPartners[i]->getAngularVelocityRadians(); // in rad/s
         sf::Vector2f tranVel = m_collisionPartners[i]->getVelocity(); // in pixel/s
         // Local velocity vector considering angular and translational velocity
         sf::Vector2f closingVel = sfu::pseudoCrossProduct(angVel, i_relativePositions[i]);
@@ -93,7 +133,7 @@ float CollisionEvent::calculateContactSpeed(std::array<sf::Vector2f, 2> i_relati
 /**
  * @brief Calculates how much the local velocity will change if a unit impulse applies. Depends on mass and moment of inertia of BOTH bodies.
  * @param i_relativePositions Array holding the relative collision location for each body in global coordinates.
- * @return The velocity change per unit impulse.
+ * @return The velocity change per unit impulse. Zero if both bodies have infinite inertia in the contact point.
  */
 float CollisionEvent::calculateDeltaVelPerUnitImpulse(std::array<sf::Vector2f, 2> i_relativePositions) const {
     float deltaVel = 0.0f;
@@ -108,32 +148,40 @@ float CollisionEvent::calculateDeltaVelPerUnitImpulse(std::array<sf::Vector2f, 2
         deltaVel += sfu::scalarProduct(velocityPerUnitImpulse1, m_collisionGeometry.normals[i]);
         deltaVel += m_collisionPartners[i]->getInverseMass();
     }
-    if (deltaVel <= 0) {
-        // This would mean infinite inertia
-        throw std::runtime_error("The collision is impossible! Maybe two bodies with inverseMass = 0 have collided?");
-    }
     return deltaVel;
 }
 
+/**
+ * @brief Transforms a vector from contact coordinates to global coordinates. The contact x axis is the collision normal (normals[0]), the
+ * contact y axis is the tangent. The normal already is the first column of the rotation matrix, so no angle is needed.
+ * @param i_contactVector The vector in contact coordinates.
+ * @return The vector in global coordinates.
+ */
+sf::Vector2f CollisionEvent::transformContactToGlobal(sf::Vector2f i_contactVector) const {
+    sf::Vector2f normal = m_collisionGeometry.normals[0];
+    sf::Vector2f tangent = sfu::pseudoCrossProduct(1.0f, normal); // normal rotated by 90 degrees
+    return sfu::addVectors(sfu::scaleVector(normal, i_contactVector.x), sfu::scaleVector(tangent, i_contactVector.y));
+}
+
 /**
  * @brief Determines the impulse each body receives.
  * @param i_relativePosition Array containing the collision location in relation to the center of mass of the respective body (in global
  * coordinates)
- * @param i_impulseContactX The impulse in contact coordinates, parallel to the contact x axis (parallel to the collision normal)
- * @param i_contactTransformationAngle
- *
+ * @param i_impulseContact The impulse body 0 receives in contact coordinates (x parallel to the collision normal, y parallel to the
+ * tangent).
  */
-void CollisionEvent::handleImpulse(std::array<sf::Vector2f, 2> i_relativePosition, float i_impulseContactX,
-        float i_contactTransformationAngle) {
-
-    sf::Vector2f impulseContact = sf::Vector2f(i_impulseContactX, 0.0f);
-
+void CollisionEvent::handleImpulse(std::array<sf::Vector2f, 2> i_relativePosition, sf::Vector2f i_impulseContact) {
     // In global coordinates
     sf::Vector2f impulse[2];
-    impulse[0] = sfu::rotateVector(impulseContact, i_contactTransformationAngle);
+    impulse[0] = transformContactToGlobal(i_impulseContact);
     impulse[1] = sfu::scaleVector(impulse[0], -1.0f); // Newton's third law
 
     for (int i = 0; i < BODIES_PER_COLLISION; i++) {
+        // Bodies with infinite inertia won't change. Skipping them also means they are never written to while the contacts are resolved
+        // in parallel.
+        if (m_collisionPartners[i]->isStatic()) {
+            continue;
+        }
         m_collisionPartners[i]->applyImpulse(i_relativePosition[i], impulse[i]);
     }
 }
@@ -19,6 +19,15 @@ struct collisionGeometry {
     sf::Vector2f normals[2] = {sf::Vector2f(), sf::Vector2f()};
 };
 
+/**
+ * @brief Outcome of CollisionEvent::resolve().
+ */
+enum class resolveResult {
+    resolved,   ///< An impulse has been applied to the bodies.
+    separating, ///< The bodies are already moving apart, nothing had to be done.
+    degenerate  ///< No impulse could be computed because both bodies have infinite inertia in the contact point.
+};
+
 /**
  * @class CollisionEvent
  * @brief Holds all needed data for modeling a collision and provides methods for resolving it.
@@ -26,24 +35,31 @@ struct collisionGeometry {
 class CollisionEvent {
 
   public:
-    CollisionEvent(RigidBody * i_rb1, RigidBody * i_rb2, const collisionGeometry & i_cg);
+    CollisionEvent(RigidBody * i_rb1, RigidBody * i_rb2, const collisionGeometry & i_cg, float i_speculativeTimeStep = 0.0f);
 
     // Destructor
     ~CollisionEvent();
 
     // Public methods
-    void resolve();
-    collisionGeometry getCollisionGeometry() const;
+    resolveResult resolve();
+    const collisionGeometry & getCollisionGeometry() const;
     float getMinSeparation() const;
+    std::array<RigidBody *, 2> getCollisionPartners() const;
+    bool isSpeculative() const;
+    float getContactSpeed() const;
+    float getAllowedContactSpeed() const;
 
   private:
     // Private methods
     sf::Vector2f computeRelativePosition(sf::Vector2f i_collLoc, sf::Vector2f i_bodyPosition);
     float calculateContactSpeed(std::array<sf::Vector2f, 2> i_relativePositions) const;
     float calculateDeltaVelPerUnitImpulse(std::array<sf::Vector2f, 2> i_relativePositions) const;
-    void handleImpulse(std::array<sf::Vector2f, 2> i_relativePosition, float i_impulseContactX, float i_contactTransformationAngle);
+    sf::Vector2f transformContactToGlobal(sf::Vector2f i_contactVector) const;
+    void handleImpulse(std::array<sf::Vector2f, 2> i_relativePosition, sf::Vector2f i_impulseContact);
 
     // Private members
     std::array<RigidBody *, 2> m_collisionPartners = {nullptr, nullptr};
     collisionGeometry m_collisionGeometry;
+    /// Time step in seconds for which a speculative contact has been generated, zero for regular contacts.
+    float m_speculativeTimeStep = 0.0f;
 };
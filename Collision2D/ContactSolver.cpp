@@ -0,0 +1,203 @@
+#include "ContactSolver.hpp"
+#include <algorithm>
+
+// Constructor.
+ContactSolver::ContactSolver() {}
+
+// Destructor.
+ContactSolver::~ContactSolver() {}
+
+std::size_t ContactSolver::getContactCount() const {
+    return m_contacts.size();
+}
+
+/**
+ * @brief The number of colors the contacts of the last solve() call were split into.
+ * @return The color count. The group of contacts which had to be resolved serially counts as one color.
+ */
+std::size_t ContactSolver::getColorCount() const {
+    return m_colorCount;
+}
+
+/**
+ * @brief The number of contacts of the last solve() call which received an impulse (see resolveResult::resolved). Contacts which were
+ * already separating don't count.
+ * @return The resolved contact count.
+ */
+std::size_t ContactSolver::getResolvedContactCount() const {
+    return m_resolvedContactCount.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief The number of contacts of the last solve() call which could not be resolved because both bodies have infinite inertia in the
+ * contact point (see resolveResult::degenerate).
+ * @return The degenerate contact count.
+ */
+std::size_t ContactSolver::getDegenerateContactCount() const {
+    return m_degenerateContactCount.load(std::memory_order_relaxed);
+}
+
+simdLevel ContactSolver::getSimdLevel() const {
+    return m_wideSolver.getSimdLevel();
+}
+
+/**
+ * @brief Choose the instruction set for resolving the contacts. By default, the best one supported by the CPU is used.
+ * @param i_simdLevel The SIMD level. Falls back to a supported one if necessary.
+ */
+void ContactSolver::setSimdLevel(simdLevel i_simdLevel) {
+    m_wideSolver = WideContactSolver(i_simdLevel);
+}
+
+/**
+ * @brief Forget the contacts of the previous step. Call this before adding the contacts of a new step.
+ * @param io_arena Holds the contacts and scratch data until it is reset. It must not be reset before solve() has returned.
+ * @param i_bodyCount The number of bodies which can be referenced by addContact().
+ */
+void ContactSolver::beginStep(FrameArena & io_arena, std::size_t i_bodyCount) {
+    m_arena = &io_arena;
+    m_contacts.reset(io_arena);
+    m_colorCount = 0;
+    m_resolvedContactCount.store(0, std::memory_order_relaxed);
+    m_degenerateContactCount.store(0, std::memory_order_relaxed);
+    m_bodyColorMasks = io_arena.allocateArray<unsigned long long>(i_bodyCount);
+    std::fill(m_bodyColorMasks, m_bodyColorMasks + i_bodyCount, 0ULL);
+}
+
+/**
+ * @brief Add a contact which will be resolved by the next solve() call.
+ * @param i_collisionEvent The collision to resolve.
+ * @param i_firstBodyIndex Index of the first collision partner, or STATIC_BODY.
+ * @param i_secondBodyIndex Index of the second collision partner, or STATIC_BODY.
+ */
+void ContactSolver::addContact(const CollisionEvent & i_collisionEvent, int i_firstBodyIndex, int i_secondBodyIndex) {
+    contactConstraint contact{i_collisionEvent, {i_firstBodyIndex, i_secondBodyIndex}};
+    // Static bodies are never changed by the collision, so they can't cause any conflicts
+    std::array<RigidBody *, 2> bodies = i_collisionEvent.getCollisionPartners();
+    for (int i = 0; i < 2; i++) {
+        if (bodies[i]->isStatic()) {
+            contact.bodyIndices[i] = STATIC_BODY;
+        }
+    }
+    m_contacts.push_back(contact);
+}
+
+/**
+ * @brief Resolve all contacts that have been added since the last beginStep() call.
+ * @param i_workerPool The threads to distribute the work to.
+ */
+void ContactSolver::solve(WorkerPool & i_workerPool) {
+    colorContacts();
+
+    for (std::size_t color = 0; color < m_colorCount; color++) {
+        std::size_t begin = m_colorOffsets[color];
+        std::size_t end = m_colorOffsets[color + 1];
+        if (color == MAX_PARALLEL_COLORS) {
+            // Left over contacts share bodies with each other, so they have to be resolved one after another
+            contactCounts counts;
+            for (std::size_t i = begin; i < end; i++) {
+                resolveResult result = m_orderedContacts[i]->resolve();
+                if (result == resolveResult::resolved) {
+                    counts.resolvedCount++;
+                } else if (result == resolveResult::degenerate) {
+                    counts.degenerateCount++;
+                }
+            }
+            countContacts(counts);
+        } else {
+            solveColor(i_workerPool, begin, end);
+        }
+    }
+}
+
+/**
+ * @brief Assign a color to every contact (greedy graph coloring) and sort the contacts by color.
+ *
+ * Every contact gets the lowest color which isn't used by one of its movable bodies yet. Contacts without any movable body and contacts
+ * for which all colors are taken end up in the serial group (color MAX_PARALLEL_COLORS).
+ */
+void ContactSolver::colorContacts() {
+    const int SERIAL_COLOR = MAX_PARALLEL_COLORS;
+    m_contactColors = m_arena->allocateArray<int>(m_contacts.size());
+    m_colorOffsets.fill(0);
+
+    for (std::size_t i = 0; i < m_contacts.size(); i++) {
+        const std::array<int, 2> & bodyIndices = m_contacts[i].bodyIndices;
+        int color = SERIAL_COLOR;
+        if (bodyIndices[0] != STATIC_BODY || bodyIndices[1] != STATIC_BODY) {
+            unsigned long long usedColors = 0;
+            for (int bodyIndex : bodyIndices) {
+                if (bodyIndex != STATIC_BODY) {
+                    usedColors |= m_bodyColorMasks[bodyIndex];
+                }
+            }
+            color = 0;
+            while (color < MAX_PARALLEL_COLORS && (usedColors & (1ULL << color)) != 0) {
+                color++;
+            }
+            if (color < MAX_PARALLEL_COLORS) {
+                for (int bodyIndex : bodyIndices) {
+                    if (bodyIndex != STATIC_BODY) {
+                        m_bodyColorMasks[bodyIndex] |= 1ULL << color;
+                    }
+                }
+            }
+        }
+        m_contactColors[i] = color;
+        // Count the contacts per color
+        m_colorOffsets[color + 1]++;
+        m_colorCount = std::max(m_colorCount, static_cast<std::size_t>(color) + 1);
+    }
+
+    // Turn the counts into offsets and sort the contacts by color (counting sort keeps the detection order within a color)
+    for (std::size_t color = 1; color < m_colorOffsets.size(); color++) {
+        m_colorOffsets[color] += m_colorOffsets[color - 1];
+    }
+    m_orderedContacts = m_arena->allocateArray<CollisionEvent *>(m_contacts.size());
+    for (std::size_t i = 0; i < m_contacts.size(); i++) {
+        m_orderedContacts[m_colorOffsets[m_contactColors[i]]++] = &m_contacts[i].event;
+    }
+    // The sort advanced every offset to the start of the next color, shift them back
+    for (std::size_t color = m_colorOffsets.size() - 1; color > 0; color--) {
+        m_colorOffsets[color] = m_colorOffsets[color - 1];
+    }
+    m_colorOffsets[0] = 0;
+}
+
+/**
+ * @brief Resolve the contacts of a single color. As none of them share a movable body, they can be resolved in SIMD batches and on
+ * different threads.
+ * @param i_workerPool The threads to distribute the work to.
+ * @param i_begin First index into m_orderedContacts.
+ * @param i_end One past the last index into m_orderedContacts.
+ */
+void ContactSolver::solveColor(WorkerPool & i_workerPool, std::size_t i_begin, std::size_t i_end) {
+    CollisionEvent * const * contacts = m_orderedContacts + i_begin;
+    std::size_t contactCount = i_end - i_begin;
+    if (contactCount < MIN_CONTACTS_FOR_PARALLEL_SOLVE) {
+        countContacts(m_wideSolver.solve(contacts, contactCount));
+        return;
+    }
+    // Every task resolves a few full batches
+    std::size_t contactsPerTask = BATCHES_PER_TASK * m_wideSolver.getLaneCount();
+    std::size_t taskCount = (contactCount + contactsPerTask - 1) / contactsPerTask;
+    auto resolveTask = [this, contacts, contactCount, contactsPerTask](std::size_t i_task) {
+        std::size_t first = i_task * contactsPerTask;
+        countContacts(m_wideSolver.solve(contacts + first, std::min(contactsPerTask, contactCount - first)));
+    };
+    i_workerPool.parallelFor(taskCount, resolveTask);
+}
+
+/**
+ * @brief Add the contacts resolved by one thread to the counts of the step. Every thread adds its counts once per task, and the atomics are
+ * only touched if there is anything to add, as degenerate contacts are rare.
+ * @param i_counts The number of resolved and degenerate contacts of the task.
+ */
+void ContactSolver::countContacts(const contactCounts & i_counts) {
+    if (i_counts.resolvedCount > 0) {
+        m_resolvedContactCount.fetch_add(i_counts.resolvedCount, std::memory_order_relaxed);
+    }
+    if (i_counts.degenerateCount > 0) {
+        m_degenerateContactCount.fetch_add(i_counts.degenerateCount, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CollisionEvent.hpp"
+#include "FrameArena.hpp"
+#include "WideContactSolver.hpp"
+#include "WorkerPool.hpp"
+#include <array>
+#include <atomic>
+
+/**
+ * @brief A detected contact together with the indices of the two bodies involved.
+ */
+struct contactConstraint {
+    /// The collision to resolve.
+    CollisionEvent event;
+    /// Index of each body in the body list of the current step, or ContactSolver::STATIC_BODY if the body cannot be moved by an impulse.
+    std::array<int, 2> bodyIndices;
+};
+
+/**
+ * @class ContactSolver
+ * @brief Collects the contacts of a time step and resolves them in parallel.
+ *
+ * A big pile of bodies forms one connected group of contacts, so it cannot be split into independent groups. Instead, the contacts are
+ * colored such that no two contacts of the same color share a movable body. All contacts of one color can then be resolved at the same
+ * time on different threads, one color after the other. Static bodies (e.g. BoundaryElement) are never changed by a collision, so they do
+ * not create any conflicts. Within a thread, the contacts of a color are resolved in SIMD batches by the
+ * WideContactSolver.
+ *
+ * The contacts and all scratch data of a step are stored in the FrameArena passed to beginStep().
+ */
+class ContactSolver {
+  public:
+    // Constructor
+    ContactSolver();
+
+    // Destructor
+    ~ContactSolver();
+
+    // Getters
+    std::size_t getContactCount() const;
+    std::size_t getColorCount() const;
+    std::size_t getResolvedContactCount() const;
+    std::size_t getDegenerateContactCount() const;
+    simdLevel getSimdLevel() const;
+
+    // Setters
+    void setSimdLevel(simdLevel i_simdLevel);
+
+    // Public methods
+    void beginStep(FrameArena & io_arena, std::size_t i_bodyCount);
+    void addContact(const CollisionEvent & i_collisionEvent, int i_firstBodyIndex, int i_secondBodyIndex);
+    void solve(WorkerPool & i_workerPool);
+
+    /// Marks a body which is not changed by any impulse.
+    static constexpr int STATIC_BODY = -1;
+
+  private:
+    /// Colors are tracked with a 64 bit mask per body. Contacts that don't fit into any of them are resolved serially afterwards.
+    static constexpr int MAX_PARALLEL_COLORS = 64;
+
+    // Private methods
+    void colorContacts();
+    void solveColor(WorkerPool & i_workerPool, std::size_t i_begin, std::size_t i_end);
+    void countContacts(const contactCounts & i_counts);
+
+    // Member variables
+    /// Holds the contacts and the scratch data of the current step.
+    FrameArena * m_arena = nullptr;
+    /// The contacts of the current step in the order they were detected.
+    FrameArray<contactConstraint> m_contacts;
+    /// The contacts sorted by color (in the arena, one entry per contact).
+    CollisionEvent ** m_orderedContacts = nullptr;
+    /// m_orderedContacts[m_colorOffsets[c]] is the first contact of color c. Has one more entry than there are colors.
+    std::array<std::size_t, MAX_PARALLEL_COLORS + 2> m_colorOffsets{};
+    /// Color of every contact, same order as m_contacts (in the arena).
+    int * m_contactColors = nullptr;
+    /// One bit per color for every body, set if the body already takes part in a contact of that color (in the arena).
+    unsigned long long * m_bodyColorMasks = nullptr;
+    /// Number of colors used in the current step.
+    std::size_t m_colorCount = 0;
+    /// Number of contacts in the current step which received an impulse. Written by all threads.
+    std::atomic<std::size_t> m_resolvedContactCount{0};
+    /// Number of contacts in the current step for which no impulse could be computed. Written by all threads.
+    std::atomic<std::size_t> m_degenerateContactCount{0};
+    /// Resolves the contacts of a color in batches.
+    WideContactSolver m_wideSolver;
+
+    /// Colors with fewer contacts than this are resolved on the calling thread, as waking up the workers would cost more than it saves.
+    static constexpr std::size_t MIN_CONTACTS_FOR_PARALLEL_SOLVE = 64;
+    /// Number of SIMD batches handed to a thread at once.
+    static constexpr std::size_t BATCHES_PER_TASK = 4;
+};
@@ -0,0 +1,73 @@
+#include "FrameArena.hpp"
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * @brief Constructor.
+ * @param i_initialCapacity Size of the first block in bytes. The arena grows to the needs of the scene by itself.
+ */
+FrameArena::FrameArena(std::size_t i_initialCapacity) : m_buffer(new unsigned char[i_initialCapacity]), m_capacity(i_initialCapacity) {}
+
+// Destructor.
+FrameArena::~FrameArena() {}
+
+/**
+ * @brief The memory handed out since the last reset().
+ * @return The used memory in bytes.
+ */
+std::size_t FrameArena::getUsedBytes() const {
+    return m_usedBytes;
+}
+
+/**
+ * @brief The size of the main block, i.e. how much memory can be handed out per step without allocating.
+ * @return The capacity in bytes.
+ */
+std::size_t FrameArena::getCapacity() const {
+    return m_capacity;
+}
+
+/**
+ * @brief The largest amount of memory a single step has used so far. Helps to choose the initial capacity for a scene.
+ * @return The high-water mark in bytes.
+ */
+std::size_t FrameArena::getHighWaterMark() const {
+    return std::max(m_highWaterMark, m_usedBytes);
+}
+
+/**
+ * @brief Reserve memory which stays valid until the next reset().
+ * @param i_size The size in bytes.
+ * @param i_alignment The alignment in bytes, must be a power of two.
+ * @return Pointer to the uninitialized memory.
+ */
+void * FrameArena::allocate(std::size_t i_size, std::size_t i_alignment) {
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_buffer.get());
+    std::size_t alignedOffset = ((base + m_offset + i_alignment - 1) & ~(i_alignment - 1)) - base;
+    if (alignedOffset + i_size <= m_capacity) {
+        m_usedBytes += alignedOffset + i_size - m_offset;
+        m_offset = alignedOffset + i_size;
+        return m_buffer.get() + alignedOffset;
+    }
+    // The main block is full. The overflow block is only used for this allocation, the next reset() makes the main block large enough.
+    std::size_t blockSize = i_size + i_alignment;
+    m_overflowBlocks.emplace_back(new unsigned char[blockSize]);
+    m_usedBytes += blockSize;
+    std::uintptr_t blockBase = reinterpret_cast<std::uintptr_t>(m_overflowBlocks.back().get());
+    return reinterpret_cast<void *>((blockBase + i_alignment - 1) & ~static_cast<std::uintptr_t>(i_alignment - 1));
+}
+
+/**
+ * @brief Free everything that has been allocated since the last reset(). All pointers into the arena become invalid.
+ */
+void FrameArena::reset() {
+    m_highWaterMark = std::max(m_highWaterMark, m_usedBytes);
+    if (!m_overflowBlocks.empty()) {
+        m_overflowBlocks.clear();
+        // Leave some headroom, so a slowly growing scene doesn't need a new block every step
+        m_capacity = std::max(m_capacity, 2 * m_highWaterMark);
+        m_buffer.reset(new unsigned char[m_capacity]);
+    }
+    m_offset = 0;
+    m_usedBytes = 0;
+}
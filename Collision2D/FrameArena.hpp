@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+/**
+ * @class FrameArena
+ * @brief Linear (bump) allocator for data that only lives for a single simulation step, e.g. candidate pairs and contacts.
+ *
+ * Allocating just moves an offset ahead, and reset() frees everything at once. If a step needs more memory than the arena holds, additional
+ * blocks are allocated from the heap. The next reset() replaces all blocks with a single one that is large enough for the biggest step so
+ * far, so the arena stops allocating once the scene has settled.
+ *
+ * @attention Destructors of objects in the arena are never called, so it must only hold objects which don't own any resources.
+ */
+class FrameArena {
+  public:
+    // Constructor
+    explicit FrameArena(std::size_t i_initialCapacity = DEFAULT_CAPACITY);
+
+    // Destructor
+    ~FrameArena();
+
+    // Getters
+    std::size_t getUsedBytes() const;
+    std::size_t getCapacity() const;
+    std::size_t getHighWaterMark() const;
+
+    // Public methods
+    void * allocate(std::size_t i_size, std::size_t i_alignment);
+    template <typename T> T * allocateArray(std::size_t i_count);
+    void reset();
+
+    /// In bytes.
+    static constexpr std::size_t DEFAULT_CAPACITY = 64 * 1024;
+
+  private:
+    // Deleted copy constructor and assignment operator
+    FrameArena(const FrameArena &) = delete;
+    FrameArena & operator=(const FrameArena &) = delete;
+
+    // Member variables
+    /// The block allocations are served from. Everything before m_offset is in use.
+    std::unique_ptr<unsigned char[]> m_buffer;
+    std::size_t m_capacity = 0;
+    std::size_t m_offset = 0;
+    /// Blocks allocated because m_buffer was full. They are merged into m_buffer by the next reset().
+    std::vector<std::unique_ptr<unsigned char[]>> m_overflowBlocks;
+    /// Bytes used in the current step, including the overflow blocks and alignment padding.
+    std::size_t m_usedBytes = 0;
+    /// Largest value of m_usedBytes so far.
+    std::size_t m_highWaterMark = 0;
+};
+
+/**
+ * @brief Reserve uninitialized memory for an array.
+ * @tparam T The element type.
+ * @param i_count The number of elements.
+ * @return Pointer to the first element. Valid until the next reset().
+ */
+template <typename T> T * FrameArena::allocateArray(std::size_t i_count) {
+    return static_cast<T *>(allocate(i_count * sizeof(T), alignof(T)));
+}
+
+/**
+ * @class FrameArray
+ * @brief A growable array stored in a FrameArena, like a std::vector which is emptied by every FrameArena::reset().
+ *
+ * When the array is full, the elements are copied to a new array of twice the size. The old array stays in the arena until the next
+ * reset(), so it costs memory but no extra allocation.
+ *
+ * @tparam T The element type. Must be copy constructible, destructors are never called.
+ */
+template <typename T> class FrameArray {
+  public:
+    // Constructor
+    FrameArray() {}
+
+    // Getters
+    std::size_t size() const {
+        return m_size;
+    }
+    bool empty() const {
+        return m_size == 0;
+    }
+    T * data() {
+        return m_data;
+    }
+    const T * data() const {
+        return m_data;
+    }
+    T & operator[](std::size_t i_index) {
+        return m_data[i_index];
+    }
+    const T & operator[](std::size_t i_index) const {
+        return m_data[i_index];
+    }
+    T * begin() {
+        return m_data;
+    }
+    T * end() {
+        return m_data + m_size;
+    }
+    const T * begin() const {
+        return m_data;
+    }
+    const T * end() const {
+        return m_data + m_size;
+    }
+
+    // Public methods
+
+    /**
+     * @brief Start over with an empty array in the given arena. Call this after the arena has been reset.
+     * @param io_arena The arena holding the elements.
+     * @param i_capacity Number of elements to reserve up front.
+     */
+    void reset(FrameArena & io_arena, std::size_t i_capacity = 0) {
+        m_arena = &io_arena;
+        m_data = i_capacity > 0 ? io_arena.allocateArray<T>(i_capacity) : nullptr;
+        m_size = 0;
+        m_capacity = i_capacity;
+    }
+
+    void push_back(const T & i_element) {
+        if (m_size == m_capacity) {
+            grow();
+        }
+        new (m_data + m_size) T(i_element);
+        m_size++;
+    }
+
+  private:
+    void grow() {
+        std::size_t newCapacity = m_capacity > 0 ? 2 * m_capacity : MIN_CAPACITY;
+        T * newData = m_arena->allocateArray<T>(newCapacity);
+        for (std::size_t i = 0; i < m_size; i++) {
+            new (newData + i) T(m_data[i]);
+        }
+        m_data = newData;
+        m_capacity = newCapacity;
+    }
+
+    // Member variables
+    FrameArena * m_arena = nullptr;
+    T * m_data = nullptr;
+    std::size_t m_size = 0;
+    std::size_t m_capacity = 0;
+
+    static constexpr std::size_t MIN_CAPACITY = 16;
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Read-only view of contiguous vertices, e.g. the corners of a body. Doesn't own the vertices, so it is cheap to copy.
+ */
+struct vertexSpan {
+    const sf::Vector2f * data = nullptr;
+    std::size_t size = 0;
+
+    const sf::Vector2f & operator[](std::size_t i_index) const {
+        return data[i_index];
+    }
+    const sf::Vector2f * begin() const {
+        return data;
+    }
+    const sf::Vector2f * end() const {
+        return data + size;
+    }
+    bool empty() const {
+        return size == 0;
+    }
+};
+
+/**
+ * @class InlineVertexArray
+ * @brief Growable array of vertices which stores up to INLINE_CAPACITY vertices inside the object itself.
+ *
+ * Most polygons only have a few corners. Keeping them inline avoids a separate heap allocation and places them next to the data they are
+ * used with. Larger arrays (e.g. the rendered points of a Circle) move to the heap.
+ */
+class InlineVertexArray {
+  public:
+    // Constructor
+    InlineVertexArray() {}
+
+    // Getters
+    std::size_t size() const {
+        return m_size;
+    }
+    const sf::Vector2f * data() const {
+        return m_size <= INLINE_CAPACITY ? m_inlineVertices.data() : m_heapVertices.data();
+    }
+    const sf::Vector2f & operator[](std::size_t i_index) const {
+        return data()[i_index];
+    }
+    vertexSpan getSpan() const {
+        return vertexSpan{data(), m_size};
+    }
+    bool isInline() const {
+        return m_size <= INLINE_CAPACITY;
+    }
+
+    // Public methods
+
+    void push_back(sf::Vector2f i_vertex) {
+        if (m_size < INLINE_CAPACITY) {
+            m_inlineVertices[m_size] = i_vertex;
+        } else {
+            if (m_size == INLINE_CAPACITY) {
+                // Move to the heap, the inline storage is full
+                m_heapVertices.assign(m_inlineVertices.begin(), m_inlineVertices.end());
+            }
+            m_heapVertices.push_back(i_vertex);
+        }
+        m_size++;
+    }
+
+    /// Number of vertices stored without a heap allocation.
+    static constexpr std::size_t INLINE_CAPACITY = 8;
+
+  private:
+    // Member variables
+    std::array<sf::Vector2f, INLINE_CAPACITY> m_inlineVertices;
+    /// Only used when there are more than INLINE_CAPACITY vertices, then it holds all of them.
+    std::vector<sf::Vector2f> m_heapVertices;
+    std::size_t m_size = 0;
+};
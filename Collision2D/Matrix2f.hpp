@@ -6,17 +6,35 @@ namespace sfu {
 /**
 * @class Matrix2f
  * @brief A matrix compatible with sf::Vector2f.
+ *
+ * Header-only, so multiplications can be inlined everywhere (also without link time optimization).
  */
 class Matrix2f {
   public:
     float m[2][2];
 
-    Matrix2f();
-    Matrix2f(float m11, float m12, float m21, float m22);
+    constexpr Matrix2f() : m{{1, 0}, {0, 1}} {}
+    constexpr Matrix2f(float m11, float m12, float m21, float m22) : m{{m11, m12}, {m21, m22}} {}
 
     sf::Vector2f multiply(sf::Vector2f i_vector) const;
-    // float getDeterminant();
-    // Matrix2f getInverse();
+    constexpr float getDeterminant() const;
 };
 
-} // namespace sfu
\ No newline at end of file
+/**
+ * @brief Multiply the matrix with a vector.
+ * @param i_vector The vector to multiply with.
+ * @return The resulting vector.
+ */
+inline sf::Vector2f Matrix2f::multiply(sf::Vector2f i_vector) const {
+    return sf::Vector2f(m[0][0] * i_vector.x + m[0][1] * i_vector.y, m[1][0] * i_vector.x + m[1][1] * i_vector.y);
+}
+
+/**
+ * @brief Calculate the determinant of the matrix.
+ * @return The determinant.
+ */
+constexpr float Matrix2f::getDeterminant() const {
+    return m[0][0] * m[1][1] - m[0][1] * m[1][0];
+}
+
+} // namespace sfu
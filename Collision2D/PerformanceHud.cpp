@@ -0,0 +1,185 @@
+#include "PerformanceHud.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdio>
+
+namespace {
+/**
+ * @brief A character of the built-in font. Five rows of three pixels, the top row in the highest bits.
+ */
+struct glyph {
+    char character;
+    std::uint16_t rows;
+};
+
+// clang-format off
+const glyph FONT[] = {
+    {'0', 0b111'101'101'101'111}, {'1', 0b010'110'010'010'111}, {'2', 0b111'001'111'100'111}, {'3', 0b111'001'111'001'111},
+    {'4', 0b101'101'111'001'001}, {'5', 0b111'100'111'001'111}, {'6', 0b111'100'111'101'111}, {'7', 0b111'001'001'010'010},
+    {'8', 0b111'101'111'101'111}, {'9', 0b111'101'111'001'111}, {'A', 0b010'101'111'101'101}, {'B', 0b110'101'110'101'110},
+    {'C', 0b011'100'100'100'011}, {'D', 0b110'101'101'101'110}, {'E', 0b111'100'110'100'111}, {'F', 0b111'100'110'100'100},
+    {'G', 0b011'100'101'101'011}, {'H', 0b101'101'111'101'101}, {'I', 0b111'010'010'010'111}, {'J', 0b001'001'001'101'010},
+    {'K', 0b101'101'110'101'101}, {'L', 0b100'100'100'100'111}, {'M', 0b101'111'111'101'101}, {'N', 0b110'101'101'101'101},
+    {'O', 0b010'101'101'101'010}, {'P', 0b110'101'110'100'100}, {'Q', 0b010'101'101'110'011}, {'R', 0b110'101'110'101'101},
+    {'S', 0b011'100'010'001'110}, {'T', 0b111'010'010'010'010}, {'U', 0b101'101'101'101'111}, {'V', 0b101'101'101'101'010},
+    {'W', 0b101'101'111'111'101}, {'X', 0b101'101'010'101'101}, {'Y', 0b101'101'010'010'010}, {'Z', 0b111'001'010'100'111},
+    {'.', 0b000'000'000'000'010}, {':', 0b000'010'000'010'000}, {'/', 0b001'001'010'100'100}, {'-', 0b000'000'111'000'000},
+};
+// clang-format on
+
+/// One color per profilePhase, in the order of the enum.
+const std::array<sf::Color, Profiler::PHASE_COUNT> PHASE_COLORS = {sf::Color(80, 160, 255), sf::Color(255, 200, 60),
+        sf::Color(255, 90, 90), sf::Color(110, 220, 110), sf::Color(200, 120, 255), sf::Color(160, 160, 160)};
+const sf::Color BACKGROUND_COLOR(0, 0, 0, 180);
+const sf::Color TEXT_COLOR(230, 230, 230);
+const sf::Color BUDGET_COLOR(255, 60, 60);
+
+const float MARGIN = 6.0f;            // In screen pixels
+const float BAR_LENGTH = 90.0f;       // Length of a phase bar which takes the whole frame budget, in screen pixels
+const int PHASE_LINE_LENGTH = 27;     // Characters of a phase line ("%-11s %7.1f %7.1f"), the bars start after it
+const float GRAPH_HEIGHT = 50.0f;     // In screen pixels, the frame budget is at half the height
+const float GRAPH_BAR_WIDTH = 2.0f;   // In screen pixels
+const std::size_t MAX_LINE_LENGTH = 64;
+} // namespace
+
+// Constructor.
+PerformanceHud::PerformanceHud() : m_vertices(sf::Triangles), m_frameTimes(GRAPH_FRAME_COUNT, 0.0f) {
+    m_sortedFrameTimes.reserve(GRAPH_FRAME_COUNT);
+}
+
+/**
+ * @brief The number of vertices of the overlay, e.g. to check how expensive it is.
+ * @return The vertex count.
+ */
+std::size_t PerformanceHud::getVertexCount() const {
+    return m_vertices.getVertexCount();
+}
+
+/**
+ * @brief The rectangles of the overlay as pairs of triangles, e.g. to check the layout.
+ * @return The vertices in screen coordinates.
+ */
+const sf::VertexArray & PerformanceHud::getVertices() const {
+    return m_vertices;
+}
+
+/**
+ * @brief Statistics of the frame times of the last GRAPH_FRAME_COUNT updates, as shown on the first line of the overlay.
+ * @return The statistics in microseconds.
+ */
+const phaseStatistics & PerformanceHud::getFrameStatistics() const {
+    return m_frameStatistics;
+}
+
+/**
+ * @brief Add a frame to the graph and rebuild the overlay from the latest statistics. Call it once per frame.
+ * @param i_profiler The times of the phases.
+ * @param i_stats The counters of the last step.
+ * @param i_frameTime The wall-clock time of the last frame in microseconds.
+ * @param i_frameBudget The time available per frame in microseconds.
+ */
+void PerformanceHud::update(const Profiler & i_profiler, const simulationStats & i_stats, float i_frameTime, float i_frameBudget) {
+    m_frameTimes[m_nextFrameTime] = i_frameTime;
+    m_nextFrameTime = (m_nextFrameTime + 1) % m_frameTimes.size();
+    m_frameTimeCount = std::min(m_frameTimeCount + 1, m_frameTimes.size());
+    m_frameStatistics = calculatePhaseStatistics(m_frameTimes, m_frameTimeCount, m_nextFrameTime, m_sortedFrameTimes);
+    const phaseStatistics & frame = m_frameStatistics;
+
+    m_vertices.clear();
+    const float LINE_COUNT = Profiler::PHASE_COUNT + 3.0f;
+    const float BAR_START = MARGIN + PHASE_LINE_LENGTH * CHARACTER_WIDTH + MARGIN;
+    float height = 2 * MARGIN + LINE_COUNT * LINE_HEIGHT + GRAPH_HEIGHT;
+    addRectangle(sf::Vector2f(0.0f, 0.0f), sf::Vector2f(BAR_START + BAR_LENGTH + MARGIN, height), BACKGROUND_COLOR);
+
+    char line[MAX_LINE_LENGTH];
+    sf::Vector2f position(MARGIN, MARGIN);
+    std::snprintf(line, sizeof(line), "FRAME %7.1f P99 %7.1f US", frame.mean, frame.p99);
+    addText(position, line, TEXT_COLOR);
+    position.y += LINE_HEIGHT;
+
+    // One line per phase with a bar showing its share of the frame budget
+    for (std::size_t phase = 0; phase < Profiler::PHASE_COUNT; phase++) {
+        profilePhase currentPhase = static_cast<profilePhase>(phase);
+        phaseStatistics statistics = i_profiler.getStatistics(currentPhase);
+        int lineLength = std::snprintf(line, sizeof(line), "%-11s %7.1f %7.1f", Profiler::getPhaseName(currentPhase), statistics.mean,
+                statistics.p99);
+        for (char * character = line; *character != '\0'; character++) {
+            *character = static_cast<char>(std::toupper(static_cast<unsigned char>(*character)));
+        }
+        addText(position, line, PHASE_COLORS[phase]);
+        float barLength = i_frameBudget > 0.0f ? std::min(1.0f, statistics.mean / i_frameBudget) * BAR_LENGTH : 0.0f;
+        // Times of 100 ms and more make the line longer, the bar must not cover their last digits
+        int textLength = std::min(lineLength, static_cast<int>(MAX_LINE_LENGTH) - 1);
+        float barStart = std::max(BAR_START, MARGIN + textLength * CHARACTER_WIDTH + MARGIN);
+        addRectangle(sf::Vector2f(barStart, position.y), sf::Vector2f(barLength, 5.0f * FONT_SCALE), PHASE_COLORS[phase]);
+        position.y += LINE_HEIGHT;
+    }
+
+    std::snprintf(line, sizeof(line), "BODIES %zu PAIRS %zu", i_stats.bodyCount, i_stats.testedPairCount);
+    addText(position, line, TEXT_COLOR);
+    position.y += LINE_HEIGHT;
+    std::snprintf(line, sizeof(line), "CONTACTS %zu COLORS %zu", i_stats.contactCount, i_stats.colorCount);
+    addText(position, line, TEXT_COLOR);
+    position.y += LINE_HEIGHT;
+
+    // Frame time graph, oldest frame on the left. The budget line is at half the height, longer frames are clipped at twice the budget.
+    float graphBottom = position.y + GRAPH_HEIGHT;
+    for (std::size_t i = 0; i < m_frameTimes.size(); i++) {
+        float frameTime = m_frameTimes[(m_nextFrameTime + i) % m_frameTimes.size()];
+        float barHeight = i_frameBudget > 0.0f ? std::min(1.0f, frameTime / (2.0f * i_frameBudget)) * GRAPH_HEIGHT : 0.0f;
+        sf::Color color = frameTime > i_frameBudget ? BUDGET_COLOR : PHASE_COLORS[0];
+        addRectangle(sf::Vector2f(MARGIN + i * GRAPH_BAR_WIDTH, graphBottom - barHeight), sf::Vector2f(GRAPH_BAR_WIDTH, barHeight), color);
+    }
+    addRectangle(sf::Vector2f(MARGIN, graphBottom - GRAPH_HEIGHT / 2.0f), sf::Vector2f(m_frameTimes.size() * GRAPH_BAR_WIDTH, 1.0f),
+            BUDGET_COLOR);
+}
+
+/**
+ * @brief Draw the overlay in screen coordinates, independent of the view of the target.
+ * @param io_target The window to draw to.
+ */
+void PerformanceHud::draw(sf::RenderTarget & io_target) const {
+    sf::View view = io_target.getView();
+    io_target.setView(io_target.getDefaultView());
+    io_target.draw(m_vertices);
+    io_target.setView(view);
+}
+
+/**
+ * @brief Add a filled rectangle as two triangles.
+ * @param i_position The top left corner.
+ * @param i_size Width and height.
+ * @param i_color The fill color.
+ */
+void PerformanceHud::addRectangle(sf::Vector2f i_position, sf::Vector2f i_size, sf::Color i_color) {
+    sf::Vector2f topRight(i_position.x + i_size.x, i_position.y);
+    sf::Vector2f bottomLeft(i_position.x, i_position.y + i_size.y);
+    sf::Vector2f bottomRight(i_position.x + i_size.x, i_position.y + i_size.y);
+    for (sf::Vector2f corner : {i_position, topRight, bottomRight, i_position, bottomRight, bottomLeft}) {
+        m_vertices.append(sf::Vertex(corner, i_color));
+    }
+}
+
+/**
+ * @brief Add a line of text, one rectangle per pixel of the font. Characters missing from the font are drawn as spaces.
+ * @param i_position The top left corner of the first character.
+ * @param i_text Upper case text.
+ * @param i_color The text color.
+ */
+void PerformanceHud::addText(sf::Vector2f i_position, const char * i_text, sf::Color i_color) {
+    for (const char * character = i_text; *character != '\0'; character++) {
+        const glyph * characterGlyph = std::find_if(std::begin(FONT), std::end(FONT), [character](const glyph & i_glyph) {
+            return i_glyph.character == *character;
+        });
+        if (characterGlyph != std::end(FONT)) {
+            for (int pixel = 0; pixel < 15; pixel++) {
+                if ((characterGlyph->rows >> (14 - pixel)) & 1) {
+                    sf::Vector2f pixelPosition(i_position.x + (pixel % 3) * FONT_SCALE, i_position.y + (pixel / 3) * FONT_SCALE);
+                    addRectangle(pixelPosition, sf::Vector2f(FONT_SCALE, FONT_SCALE), i_color);
+                }
+            }
+        }
+        i_position.x += CHARACTER_WIDTH;
+    }
+}
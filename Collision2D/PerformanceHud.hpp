@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Profiler.hpp"
+#include "SimulationStats.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class PerformanceHud
+ * @brief An overlay showing the frame time, the time of every phase, body and contact counts and a graph of the last frame times.
+ *
+ * The frame time is the wall-clock time of a whole frame as measured by the caller, so it includes the overlay itself and everything else
+ * that isn't covered by a phase of the Profiler.
+ *
+ * Everything, including the text, is built from rectangles in a single sf::VertexArray, so the whole overlay is one draw call and doesn't
+ * need a font file. The text uses a built-in 3x5 pixel font. The vertex array keeps its memory between frames, so updating the overlay
+ * doesn't allocate once the text length has settled.
+ */
+class PerformanceHud {
+  public:
+    // Constructor
+    PerformanceHud();
+
+    // Getters
+    std::size_t getVertexCount() const;
+    const sf::VertexArray & getVertices() const;
+    const phaseStatistics & getFrameStatistics() const;
+
+    // Public methods
+    void update(const Profiler & i_profiler, const simulationStats & i_stats, float i_frameTime, float i_frameBudget);
+    void draw(sf::RenderTarget & io_target) const;
+
+    /// Number of frames in the frame time graph.
+    static constexpr std::size_t GRAPH_FRAME_COUNT = 120;
+
+  private:
+    // Private methods
+    void addRectangle(sf::Vector2f i_position, sf::Vector2f i_size, sf::Color i_color);
+    void addText(sf::Vector2f i_position, const char * i_text, sf::Color i_color);
+
+    // Member variables
+    /// Rectangles as pairs of triangles, in screen coordinates.
+    sf::VertexArray m_vertices;
+    /// Frame times of the last frames in microseconds (ring buffer).
+    std::vector<float> m_frameTimes;
+    /// Position in m_frameTimes where the next frame time is stored.
+    std::size_t m_nextFrameTime = 0;
+    /// Number of valid entries in m_frameTimes.
+    std::size_t m_frameTimeCount = 0;
+    /// Scratch buffer for the percentile, keeps its capacity.
+    std::vector<float> m_sortedFrameTimes;
+    /// Statistics of the frame times shown on the first line.
+    phaseStatistics m_frameStatistics;
+
+    /// Size of a pixel of the font in screen pixels.
+    static constexpr float FONT_SCALE = 2.0f;
+    /// Distance from one character to the next in screen pixels, three pixels of the font and a gap.
+    static constexpr float CHARACTER_WIDTH = 4.0f * FONT_SCALE;
+    /// Distance between two lines of text in screen pixels.
+    static constexpr float LINE_HEIGHT = 7.0f * FONT_SCALE;
+};
@@ -5,11 +5,7 @@
  * @brief Constructor
  * @param i_playerBody A pointer to the body to be controlled.
  */
-PlayerController::PlayerController(RigidBody * i_playerBody) : m_playerBody(i_playerBody) {
-    i_playerBody->setOutlineColor(sf::Color::Red);
-    i_playerBody->setFillColor(sf::Color::Black);
-    i_playerBody->setOutlineThickness(-2.0f);
-}
+PlayerController::PlayerController(RigidBody * i_playerBody) : m_playerBody(i_playerBody) {}
 
 PlayerController::~PlayerController() {
     delete m_playerBody;
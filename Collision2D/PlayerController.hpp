@@ -1,5 +1,7 @@
 #pragma once
 #include "RigidBody.hpp"
+#include <SFML/Window/Keyboard.hpp>
+#include <limits>
 
 static const float FLOAT_MAX = std::numeric_limits<float>::max();
 static const float FLOAT_LOWEST = std::numeric_limits<float>::lowest();
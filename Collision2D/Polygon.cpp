@@ -3,37 +3,24 @@
 #include <iostream>
 
 /**
- * @brief Constructor.
+ * @brief Constructor. Creates a new shape definition, use the other constructor to share the geometry between many polygons.
  * @param i_inverseMass The inverse mass of the body. Put in zero for an immovable body.
  * @param i_vertices A vector holding the coordinates of the Polygon's corners. Define them in counter-clockwise order.
  * 
  * @note Polygon has to be convex to make the SAT algorithm work correctly.
  */
-Polygon::Polygon(float i_inverseMass, std::vector<sf::Vector2f> i_vertices) : VertexBasedBody(i_inverseMass, i_vertices) {
-    
-}
-
-Polygon::~Polygon() {}
+Polygon::Polygon(float i_inverseMass, std::vector<sf::Vector2f> i_vertices)
+    : VertexBasedBody(i_inverseMass, ShapeDefinition::createPolygon(i_vertices)) {}
 
 /**
- * @brief Return a normal vector corresponding to an edge.
- * @param i_index The index of the edge.
- * @return The normal vector in body coordinates.
+ * @brief Constructor.
+ * @param i_inverseMass The inverse mass of the body. Put in zero for an immovable body.
+ * @param i_shape A shape definition created with ShapeDefinition::createPolygon().
  */
-sf::Vector2f Polygon::getNormal(int i_index) {
-    // subtract vertices
-    int incrIndex = (i_index + 1) % m_points.size();
-    // if (i_index == (m_points.size() - 1)) {
-    //     edge = sf::Vector2f(m_points[i_index].x - m_points[0].x, m_points[i_index].y - m_points[0].y);
-    // } else {
-    sf::Vector2f edge = sfu::subtractVectors(m_points[i_index], m_points[incrIndex]);
-    // edge = sf::Vector2f(m_points[i_index].x - m_points[i_index + 1].x, m_points[i_index].y - m_points[i_index + 1].y);
-    // }
-    float vectorLength = (float)sqrt(pow(edge.x, 2) + pow(edge.y, 2));
-    sf::Vector2f normal = sfu::rotateVector(edge, -90.0f);
-    normal = sfu::normalizeVector(normal);
-    return normal;
-}
+Polygon::Polygon(float i_inverseMass, std::shared_ptr<const ShapeDefinition> i_shape)
+    : VertexBasedBody(i_inverseMass, std::move(i_shape)) {}
+
+Polygon::~Polygon() {}
 
 /**
  * @brief Calculates the separation of a single point from the polygon using a simplified SAT algorithm.
@@ -61,7 +48,3 @@ pointSeparationData_type Polygon::calculateMinPointSeparation(sf::Vector2f i_poi
 
     return separationData;
 }
-
-size_t Polygon::getNormalCount() {
-    return getPointCount();
-}
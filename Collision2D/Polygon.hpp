@@ -14,12 +14,11 @@ class Polygon : public VertexBasedBody {
     // Constructor
     Polygon(float i_inverseMass = 0.1, std::vector<sf::Vector2f> i_vertices = {sf::Vector2f(25.0f, -25.0f), sf::Vector2f(-25.0f, -25.0f),
                                                sf::Vector2f(-25.0f, 25.0f), sf::Vector2f(25.0f, 25.0f)});
+    Polygon(float i_inverseMass, std::shared_ptr<const ShapeDefinition> i_shape);
 
     // Destructor
     ~Polygon();
     
     // Public methods
-    sf::Vector2f getNormal(int i_index) override;
     pointSeparationData_type calculateMinPointSeparation(sf::Vector2f i_point) override;
-    size_t getNormalCount() override;
 };
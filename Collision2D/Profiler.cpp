@@ -0,0 +1,177 @@
+#include "Profiler.hpp"
+#include <algorithm>
+
+/**
+ * @brief Constructor.
+ * @param i_windowSize The number of frames the statistics are calculated from.
+ */
+Profiler::Profiler(std::size_t i_windowSize) {
+    for (std::vector<float> & samples : m_samples) {
+        samples.resize(i_windowSize, 0.0f);
+    }
+    m_frameSamples.resize(i_windowSize, 0.0f);
+    m_sortedSamples.reserve(i_windowSize);
+    reset();
+}
+
+/**
+ * @brief Timing statistics of a phase over the last frames.
+ * @param i_phase The phase.
+ * @return The statistics, all zero if no frame has been recorded yet.
+ */
+phaseStatistics Profiler::getStatistics(profilePhase i_phase) const {
+    return calculateStatistics(m_samples[static_cast<std::size_t>(i_phase)]);
+}
+
+/**
+ * @brief Timing statistics of the sum of all phases over the last frames.
+ * @return The statistics, all zero if no frame has been recorded yet.
+ */
+phaseStatistics Profiler::getFrameStatistics() const {
+    return calculateStatistics(m_frameSamples);
+}
+
+/**
+ * @brief The maximum number of frames the statistics are calculated from.
+ * @return The number of frames.
+ */
+std::size_t Profiler::getWindowSize() const {
+    return m_frameSamples.size();
+}
+
+/**
+ * @brief The number of frames recorded since the construction or the last reset().
+ * @return The number of frames.
+ */
+std::uint64_t Profiler::getFrameCount() const {
+    return m_frameCount;
+}
+
+/**
+ * @brief A readable name of a phase, e.g. for reports.
+ * @param i_phase The phase.
+ * @return The name.
+ */
+const char * Profiler::getPhaseName(profilePhase i_phase) {
+    switch (i_phase) {
+    case profilePhase::broadphase:
+        return "broadphase";
+    case profilePhase::narrowphase:
+        return "narrowphase";
+    case profilePhase::solve:
+        return "solve";
+    case profilePhase::integrate:
+        return "integrate";
+    case profilePhase::render:
+        return "render";
+    case profilePhase::events:
+        return "events";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Record the phases and frames in a TraceRecorder as well.
+ * @param i_traceRecorder The recorder, or nullptr to stop recording. Spans are only recorded while the recorder is recording.
+ */
+void Profiler::setTraceRecorder(TraceRecorder * i_traceRecorder) {
+    m_traceRecorder = i_traceRecorder;
+}
+
+/**
+ * @brief Add time to a phase of the current frame.
+ * @param i_phase The phase.
+ * @param i_duration The time spent in the phase.
+ */
+void Profiler::addTime(profilePhase i_phase, clock::duration i_duration) {
+    m_currentFrame[static_cast<std::size_t>(i_phase)] += i_duration;
+}
+
+/**
+ * @brief Add a timed section of the simulation thread to a phase of the current frame. Usually called by a ScopedTimer.
+ * @param i_phase The phase.
+ * @param i_start Beginning of the section.
+ * @param i_end End of the section.
+ */
+void Profiler::addSpan(profilePhase i_phase, clock::time_point i_start, clock::time_point i_end) {
+    addTime(i_phase, i_end - i_start);
+    if (m_traceRecorder != nullptr) {
+        m_traceRecorder->record(getPhaseName(i_phase), 0, i_start, i_end);
+    }
+}
+
+/**
+ * @brief Store the times of the current frame in the window and start a new frame.
+ */
+void Profiler::endFrame() {
+    if (!IS_ENABLED || m_frameSamples.empty()) {
+        return;
+    }
+    float frameTime = 0.0f;
+    for (std::size_t phase = 0; phase < PHASE_COUNT; phase++) {
+        float phaseTime = std::chrono::duration<float, std::micro>(m_currentFrame[phase]).count();
+        m_samples[phase][m_nextSample] = phaseTime;
+        frameTime += phaseTime;
+        m_currentFrame[phase] = clock::duration::zero();
+    }
+    m_frameSamples[m_nextSample] = frameTime;
+    m_nextSample = (m_nextSample + 1) % m_frameSamples.size();
+    m_frameCount++;
+
+    clock::time_point frameEnd = clock::now();
+    if (m_traceRecorder != nullptr) {
+        m_traceRecorder->record("frame", 0, m_frameStart, frameEnd);
+    }
+    m_frameStart = frameEnd;
+}
+
+/**
+ * @brief Forget all recorded frames.
+ */
+void Profiler::reset() {
+    m_currentFrame.fill(clock::duration::zero());
+    m_nextSample = 0;
+    m_frameCount = 0;
+    m_frameStart = clock::now();
+}
+
+/**
+ * @brief Calculate the statistics of the valid samples in a ring buffer.
+ * @param i_samples The ring buffer.
+ * @return The statistics.
+ */
+phaseStatistics Profiler::calculateStatistics(const std::vector<float> & i_samples) const {
+    std::size_t sampleCount = static_cast<std::size_t>(std::min<std::uint64_t>(m_frameCount, i_samples.size()));
+    return calculatePhaseStatistics(i_samples, sampleCount, m_nextSample, m_sortedSamples);
+}
+
+/**
+ * @brief Calculate min, mean, p99, max and the last value of the valid samples in a ring buffer of times.
+ * @param i_samples The ring buffer. Until it has wrapped around, the valid samples are at its beginning.
+ * @param i_sampleCount The number of valid samples.
+ * @param i_nextSample Position in i_samples where the next sample will be stored.
+ * @param io_sortedSamples Scratch buffer for the percentile. Reserve i_samples.size() to avoid allocations.
+ * @return The statistics, all zero if there are no samples.
+ */
+phaseStatistics calculatePhaseStatistics(const std::vector<float> & i_samples, std::size_t i_sampleCount, std::size_t i_nextSample,
+        std::vector<float> & io_sortedSamples) {
+    phaseStatistics statistics;
+    if (i_sampleCount == 0) {
+        return statistics;
+    }
+    io_sortedSamples.assign(i_samples.begin(), i_samples.begin() + i_sampleCount);
+    std::sort(io_sortedSamples.begin(), io_sortedSamples.end());
+    double sum = 0.0;
+    for (float sample : io_sortedSamples) {
+        sum += sample;
+    }
+    statistics.min = io_sortedSamples.front();
+    statistics.max = io_sortedSamples.back();
+    statistics.mean = static_cast<float>(sum / i_sampleCount);
+    // Nearest rank method
+    std::size_t p99Rank = (i_sampleCount * 99 + 99) / 100;
+    statistics.p99 = io_sortedSamples[p99Rank - 1];
+    statistics.last = i_samples[(i_nextSample + i_samples.size() - 1) % i_samples.size()];
+    statistics.frameCount = i_sampleCount;
+    return statistics;
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "TraceRecorder.hpp"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Define COLLISION2D_DISABLE_PROFILING to compile all scoped timers out of the engine.
+#ifdef COLLISION2D_DISABLE_PROFILING
+#define COLLISION2D_PROFILE_SCOPE(i_profiler, i_phase)
+#else
+#define COLLISION2D_PROFILE_SCOPE(i_profiler, i_phase) ScopedTimer COLLISION2D_TIMER_NAME(__LINE__)((i_profiler), (i_phase))
+#endif
+// Two levels, so __LINE__ is expanded before it is pasted
+#define COLLISION2D_TIMER_NAME(i_line) COLLISION2D_CONCAT(scopedTimer, i_line)
+#define COLLISION2D_CONCAT(i_first, i_second) i_first##i_second
+
+/**
+ * @brief The phases of a frame which are timed separately by the Profiler.
+ */
+enum class profilePhase {
+    /// Finding the candidate pairs (Simulation::collectCandidatePairs()).
+    broadphase,
+    /// Collision detection for the candidate pairs.
+    narrowphase,
+    /// Resolving the contacts in the ContactSolver.
+    solve,
+    /// Moving the bodies, including the continuous collision detection of bullets.
+    integrate,
+    /// Drawing the bodies and displaying the window.
+    render,
+    /// Handling the window events.
+    events
+};
+
+/**
+ * @brief Timing statistics of one phase over the frames in the window of the Profiler. All times are in microseconds.
+ */
+struct phaseStatistics {
+    float min = 0.0f;
+    float mean = 0.0f;
+    /// 99th percentile, i.e. only one frame in a hundred takes longer.
+    float p99 = 0.0f;
+    float max = 0.0f;
+    /// Time of the most recent frame.
+    float last = 0.0f;
+    /// Number of frames the statistics are based on.
+    std::size_t frameCount = 0;
+};
+
+phaseStatistics calculatePhaseStatistics(const std::vector<float> & i_samples, std::size_t i_sampleCount, std::size_t i_nextSample,
+        std::vector<float> & io_sortedSamples);
+
+/**
+ * @class Profiler
+ * @brief Measures how long each phase of a frame takes and keeps the times of the last frames for statistics.
+ *
+ * Phases are timed with ScopedTimers (use COLLISION2D_PROFILE_SCOPE), which add the elapsed time to the current frame. A phase may be
+ * timed several times per frame. endFrame() stores the accumulated times in a ring buffer, so the statistics always cover a sliding
+ * window of the most recent frames. Nothing is allocated after construction.
+ *
+ * If a TraceRecorder has been set, every timed phase and every frame is also recorded as a span for a timeline view.
+ */
+class Profiler {
+  public:
+    using clock = TraceRecorder::clock;
+
+    // Constructor
+    explicit Profiler(std::size_t i_windowSize = DEFAULT_WINDOW_SIZE);
+
+    // Getters
+    phaseStatistics getStatistics(profilePhase i_phase) const;
+    phaseStatistics getFrameStatistics() const;
+    std::size_t getWindowSize() const;
+    std::uint64_t getFrameCount() const;
+    static const char * getPhaseName(profilePhase i_phase);
+
+    // Setters
+    void setTraceRecorder(TraceRecorder * i_traceRecorder);
+
+    // Public methods
+    void addTime(profilePhase i_phase, clock::duration i_duration);
+    void addSpan(profilePhase i_phase, clock::time_point i_start, clock::time_point i_end);
+    void endFrame();
+    void reset();
+
+    static constexpr std::size_t PHASE_COUNT = static_cast<std::size_t>(profilePhase::events) + 1;
+    /// Two seconds at the default frame rate of the Simulation.
+    static constexpr std::size_t DEFAULT_WINDOW_SIZE = 240;
+    /// False if the profiler has been compiled out with COLLISION2D_DISABLE_PROFILING.
+#ifdef COLLISION2D_DISABLE_PROFILING
+    static constexpr bool IS_ENABLED = false;
+#else
+    static constexpr bool IS_ENABLED = true;
+#endif
+
+  private:
+    // Private methods
+    phaseStatistics calculateStatistics(const std::vector<float> & i_samples) const;
+
+    // Member variables
+    /// Time accumulated per phase in the current frame.
+    std::array<clock::duration, PHASE_COUNT> m_currentFrame;
+    /// Times of the last frames in microseconds, one ring buffer per phase.
+    std::array<std::vector<float>, PHASE_COUNT> m_samples;
+    /// Sum of all phases of the last frames in microseconds.
+    std::vector<float> m_frameSamples;
+    /// Position in the ring buffers where the next frame is stored.
+    std::size_t m_nextSample = 0;
+    /// Number of frames recorded since the last reset().
+    std::uint64_t m_frameCount = 0;
+    /// Scratch buffer for sorting the samples, so getting the statistics doesn't allocate.
+    mutable std::vector<float> m_sortedSamples;
+    /// Receives the spans of the phases and frames, may be nullptr.
+    TraceRecorder * m_traceRecorder = nullptr;
+    /// Beginning of the current frame.
+    clock::time_point m_frameStart;
+};
+
+/**
+ * @class ScopedTimer
+ * @brief Adds the time between its construction and its destruction to a phase of a Profiler.
+ */
+class ScopedTimer {
+  public:
+    ScopedTimer(Profiler & io_profiler, profilePhase i_phase)
+        : m_profiler(io_profiler), m_phase(i_phase), m_start(Profiler::clock::now()) {}
+    ~ScopedTimer() {
+        m_profiler.addSpan(m_phase, m_start, Profiler::clock::now());
+    }
+
+  private:
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer & operator=(const ScopedTimer &) = delete;
+
+    Profiler & m_profiler;
+    profilePhase m_phase;
+    Profiler::clock::time_point m_start;
+};
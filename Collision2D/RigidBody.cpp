@@ -1,62 +1,181 @@
 #include "RigidBody.hpp"
 #include "sfml_utility.hpp"
+#include <cmath>
 
-RigidBody::RigidBody(float i_inverseMass) : Shape(), m_inverseMass(i_inverseMass) {}
+/**
+ * @brief Constructor. Takes everything which only depends on the geometry from the shape definition, so no geometry is calculated here.
+ * @param i_inverseMass Inverse mass. Put in zero for an immovable body.
+ * @param i_shape The geometry of the body.
+ */
+RigidBody::RigidBody(float i_inverseMass, std::shared_ptr<const ShapeDefinition> i_shape) : m_shape(std::move(i_shape)) {
+    m_state.shape = m_shape.get();
+    m_state.inverseMass = i_inverseMass;
+    m_state.inverseMomentOfInertia = i_inverseMass * m_shape->getUnitInverseMomentOfInertia();
+    m_state.boundingRadius = m_shape->getBoundingRadius();
+}
 
 RigidBody::~RigidBody() {}
 
 std::size_t RigidBody::getPointCount() const {
-    return m_points.size();
+    return m_state.shape->getVertices().size;
 }
 
 /**
- * @brief Required by SFML to render bodies.
+ * @brief Used to render bodies.
  * @param i_index The point index.
  * @return Position of a corner in body coordinates-
  */
 sf::Vector2f RigidBody::getPoint(std::size_t i_index) const {
-    if (i_index < m_points.size()) {
-        return m_points[i_index];
+    vertexSpan vertices = m_state.shape->getVertices();
+    if (i_index < vertices.size) {
+        return vertices[i_index];
     }
     return sf::Vector2f(0.0f, 0.0f); // Fallback
 }
 
+/**
+ * @brief The position of the center of mass.
+ * @return The position in pixels.
+ */
+sf::Vector2f RigidBody::getPosition() const {
+    return m_state.position;
+}
+
+/**
+ * @brief The rotation angle like sf::Transformable::getRotation() returns it.
+ * @return The angle in degrees within [0, 360).
+ */
+float RigidBody::getRotation() const {
+    return m_state.orientation * sfu::RAD_TO_DEG;
+}
+
 float RigidBody::getInverseMass() const {
-    return m_inverseMass;
+    return m_state.inverseMass;
 }
 
 float RigidBody::getInverseMomentOfInertia() const {
-    return m_inverseMomentOfInertia;
+    return m_state.inverseMomentOfInertia;
 }
 
 sf::Vector2f RigidBody::getVelocity() const {
-    return m_velocity;
+    return m_state.velocity;
 }
 
 // In degrees per second
 float RigidBody::getAngularVelocity() const {
-    return m_angularVelocity;
+    return m_state.angularVelocity * sfu::RAD_TO_DEG;
+}
+
+// In radians per second
+float RigidBody::getAngularVelocityRadians() const {
+    return m_state.angularVelocity;
+}
+
+// In radians
+float RigidBody::getOrientation() const {
+    return m_state.orientation;
 }
 
 float RigidBody::getRestitutionCoefficient() const {
-    return m_restitutionCoefficient;
+    return m_state.restitutionCoefficient;
 }
 
 float RigidBody::getFrictionCoefficient() const {
     return m_timeNormalizedFrictionCoefficient;
 }
 
+/**
+ * @brief Checks if the body has infinite translational and rotational inertia, i.e. it can't be moved by any impulse.
+ * @return true if the body is static.
+ */
+bool RigidBody::isStatic() const {
+    return m_state.inverseMass == 0.0f && m_state.inverseMomentOfInertia == 0.0f;
+}
+
+bool RigidBody::isBullet() const {
+    return m_isBullet;
+}
+
+/**
+ * @brief The radius of the smallest circle around the center of mass which contains the whole body.
+ * @return The radius in pixels.
+ */
+float RigidBody::getBoundingRadius() const {
+    return m_state.boundingRadius;
+}
+
+/**
+ * @brief The data which is needed in every time step, in a single cache line.
+ * @return The state of the body.
+ */
+const bodyState & RigidBody::getState() const {
+    return m_state;
+}
+
+/**
+ * @brief The geometry of the body.
+ * @return The shape definition.
+ */
+const ShapeDefinition & RigidBody::getShape() const {
+    return *m_state.shape;
+}
+
+/**
+ * @brief The geometry of the body, e.g. to create more bodies of the same shape.
+ * @return Pointer to the shared shape definition.
+ */
+const std::shared_ptr<const ShapeDefinition> & RigidBody::getSharedShape() const {
+    return m_shape;
+}
+
+void RigidBody::setPosition(sf::Vector2f i_position) {
+    m_state.position = i_position;
+}
+
+void RigidBody::setPosition(float i_x, float i_y) {
+    m_state.position = sf::Vector2f(i_x, i_y);
+}
+
 void RigidBody::setVelocity(sf::Vector2f i_newVel) {
-    m_velocity = i_newVel;
+    m_state.velocity = i_newVel;
 }
 
 // In degrees per second
 void RigidBody::setAngularVelocity(float i_newAngVel) {
-    m_angularVelocity = i_newAngVel;
+    m_state.angularVelocity = i_newAngVel * sfu::DEG_TO_RAD;
+}
+
+// In radians per second
+void RigidBody::setAngularVelocityRadians(float i_newAngVel) {
+    m_state.angularVelocity = i_newAngVel;
+}
+
+/**
+ * @brief Set the rotation angle of the body and update the cached cosine and sine.
+ * @param i_orientation The angle in radians. Clockwise is positive.
+ */
+void RigidBody::setOrientation(float i_orientation) {
+    const float FULL_TURN = 2 * sfu::PI;
+    // Keep the angle in [0, 2*PI) like sf::Transformable does with degrees
+    i_orientation = std::fmod(i_orientation, FULL_TURN);
+    if (i_orientation < 0) {
+        i_orientation += FULL_TURN;
+    }
+    m_state.orientation = i_orientation;
+    m_state.cosOrientation = std::cos(i_orientation);
+    m_state.sinOrientation = std::sin(i_orientation);
+}
+
+/**
+ * @brief Set the rotation angle of the body.
+ * @param i_angle The angle in degrees. Clockwise is positive.
+ */
+void RigidBody::setRotation(float i_angle) {
+    setOrientation(i_angle * sfu::DEG_TO_RAD);
 }
 
 void RigidBody::setRestitutionCoefficient(float i_restitutionCoefficient) {
-    m_restitutionCoefficient = i_restitutionCoefficient;
+    m_state.restitutionCoefficient = i_restitutionCoefficient;
 }
 
 /**
@@ -67,6 +186,16 @@ void RigidBody::setFrictionCoefficient(float i_frictionCoefficient) {
     m_timeNormalizedFrictionCoefficient = i_frictionCoefficient;
 }
 
+/**
+ * @brief Flag the body as bullet. Use this for small, fast bodies which would otherwise tunnel through thin bodies like BoundaryElements.
+ * Bullets are moved by continuous collision detection (see CollisionDetector::calculateTimeOfImpact()), which is considerably more
+ * expensive than the normal update.
+ * @param i_isBullet true to enable continuous collision detection for this body.
+ */
+void RigidBody::setBullet(bool i_isBullet) {
+    m_isBullet = i_isBullet;
+}
+
 /**
  * @brief Move the body one time step ahead with the current velocity and angular velocity. Updates the position and rotation and applies
  * movement friction.
@@ -75,11 +204,13 @@ void RigidBody::setFrictionCoefficient(float i_frictionCoefficient) {
  */
 void RigidBody::updateBody(float i_dT) {
     // Apply translation and rotation
-    move(m_velocity.x * i_dT, m_velocity.y * i_dT);
-    rotate(m_angularVelocity * i_dT);
+    move(m_state.velocity.x * i_dT, m_state.velocity.y * i_dT);
+    if (m_state.angularVelocity != 0.0f) {
+        setOrientation(m_state.orientation + m_state.angularVelocity * i_dT);
+    }
     // Account for movement friction
-    m_velocity = sfu::scaleVector(m_velocity, 1.0f - m_timeNormalizedFrictionCoefficient * i_dT);
-    m_angularVelocity = m_angularVelocity * (1.0f - m_timeNormalizedFrictionCoefficient * i_dT);
+    m_state.velocity = sfu::scaleVector(m_state.velocity, 1.0f - m_timeNormalizedFrictionCoefficient * i_dT);
+    m_state.angularVelocity = m_state.angularVelocity * (1.0f - m_timeNormalizedFrictionCoefficient * i_dT);
 }
 
 /**
@@ -90,15 +221,36 @@ void RigidBody::updateBody(float i_dT) {
  */
 void RigidBody::applyImpulse(sf::Vector2f i_relativePosition, sf::Vector2f i_impulse) {
     // Change of the translational velocity
-    sf::Vector2f velocityChange = sfu::scaleVector(i_impulse, m_inverseMass);
+    sf::Vector2f velocityChange = sfu::scaleVector(i_impulse, m_state.inverseMass);
     // Change in the angular velocity
     float impulsiveTorque = sfu::pseudoCrossProduct(i_relativePosition, i_impulse);
-    float angularVelocityChange = m_inverseMomentOfInertia * impulsiveTorque;
+    float angularVelocityChange = m_state.inverseMomentOfInertia * impulsiveTorque;
     // Calculate new translational and angular velocity
-    sf::Vector2f newVel = sfu::addVectors(m_velocity, velocityChange);
-    float newAngVel = m_angularVelocity + angularVelocityChange * 180 / sfu::PI;
+    sf::Vector2f newVel = sfu::addVectors(m_state.velocity, velocityChange);
+    float newAngVel = m_state.angularVelocity + angularVelocityChange;
     setVelocity(newVel);
-    setAngularVelocity(newAngVel);
+    setAngularVelocityRadians(newAngVel);
+}
+
+/**
+ * @brief Move the body without changing its velocity.
+ * @param i_offset The offset in pixels.
+ */
+void RigidBody::move(sf::Vector2f i_offset) {
+    m_state.position = sfu::addVectors(m_state.position, i_offset);
+}
+
+void RigidBody::move(float i_offsetX, float i_offsetY) {
+    m_state.position.x += i_offsetX;
+    m_state.position.y += i_offsetY;
+}
+
+/**
+ * @brief Rotate the body relative to its current rotation.
+ * @param i_angle The angle to add in degrees.
+ */
+void RigidBody::rotate(float i_angle) {
+    setOrientation(m_state.orientation + i_angle * sfu::DEG_TO_RAD);
 }
 
 /**
@@ -106,12 +258,11 @@ void RigidBody::applyImpulse(sf::Vector2f i_relativePosition, sf::Vector2f i_imp
  * @param i_localPoint The point to transform in body coordinates.
  * @return The point in global coordinates.
  */
-sf::Vector2f RigidBody::transformPointToGlobal(sf::Vector2f i_localPoint) {
+sf::Vector2f RigidBody::transformPointToGlobal(sf::Vector2f i_localPoint) const {
     // Body position will be the new origin
-    sf::Vector2f localOrigin = getPosition();
-    // Rotation angke for the coordinate transformation is the body's rotation angle
-    float angle = getRotation();
-    return sfu::transformPoint(i_localPoint, localOrigin, angle);
+    sf::Vector2f localOrigin = m_state.position;
+    // Rotate by the body's rotation angle (cosine and sine are cached)
+    return sfu::addVectors(sfu::rotateVector(i_localPoint, m_state.cosOrientation, m_state.sinOrientation), localOrigin);
 }
 
 /**
@@ -119,20 +270,7 @@ sf::Vector2f RigidBody::transformPointToGlobal(sf::Vector2f i_localPoint) {
  * @param i_localVector The vector to transform in global coordinates.
  * @return The point in body coordinates.
  */
-sf::Vector2f RigidBody::transformVectorToGlobal(sf::Vector2f i_localVector) {
-    float angle = getRotation();
-    // Multiply with rotation matrix
-    return sfu::rotateVector(i_localVector, angle);
-}
-
-/**
- * @brief Calculate the inverse density of the body.
- * 
- * @note Calculate area first.
- * 
- * @return The density.
- */
-float RigidBody::calculateInverseDensity() const {
-    // Area divided my mass
-    return m_area * m_inverseMass;
+sf::Vector2f RigidBody::transformVectorToGlobal(sf::Vector2f i_localVector) const {
+    // Multiply with rotation matrix (cosine and sine are cached)
+    return sfu::rotateVector(i_localVector, m_state.cosOrientation, m_state.sinOrientation);
 }
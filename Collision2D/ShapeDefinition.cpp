@@ -0,0 +1,201 @@
+#include "ShapeDefinition.hpp"
+#include "AllocationTracker.hpp"
+#include "sfml_utility.hpp"
+#include <algorithm>
+#include <cmath>
+
+// Constructor.
+ShapeDefinition::ShapeDefinition() {}
+
+/**
+ * @brief Create the definition of a convex polygon. The vertices are moved, so the center of mass is at {0,0}.
+ * @param i_vertices The corners of the polygon. Define them in counter-clockwise order.
+ * @return The shared definition.
+ */
+std::shared_ptr<const ShapeDefinition> ShapeDefinition::createPolygon(const std::vector<sf::Vector2f> & i_vertices) {
+    COLLISION2D_MEMORY_SCOPE(memorySubsystem::shapes);
+    std::shared_ptr<ShapeDefinition> shape(new ShapeDefinition());
+    shape->m_area = std::abs(calculateSignedArea(i_vertices));
+    shape->m_centerOfMass = calculateCenterOfMass(i_vertices);
+
+    // Redefine all the vertices, so the center of mass is at {0,0}
+    for (const sf::Vector2f & vertex : i_vertices) {
+        shape->m_vertices.push_back(sfu::subtractVectors(vertex, shape->m_centerOfMass));
+    }
+    shape->m_unitInverseMomentOfInertia = calculateUnitInverseMomentOfInertia(shape->m_vertices.getSpan());
+
+    // One normal per edge, perpendicular to the edge and facing outwards
+    std::size_t vertexCount = shape->m_vertices.size();
+    for (std::size_t i = 0; i < vertexCount; i++) {
+        sf::Vector2f edge = sfu::subtractVectors(shape->m_vertices[i], shape->m_vertices[(i + 1) % vertexCount]);
+        shape->m_normals.push_back(sfu::normalizeVector(sfu::rotateVector(edge, -90.0f)));
+    }
+    shape->calculateBoundingRadius();
+    return shape;
+}
+
+/**
+ * @brief Create the definition of a circle.
+ * @param i_radius Radius in pixels.
+ * @param i_resolution The amount of rendered vertices. Irrelevant for physics.
+ * @return The shared definition.
+ */
+std::shared_ptr<const ShapeDefinition> ShapeDefinition::createCircle(float i_radius, int i_resolution) {
+    COLLISION2D_MEMORY_SCOPE(memorySubsystem::shapes);
+    std::shared_ptr<ShapeDefinition> shape(new ShapeDefinition());
+    shape->m_type = shapeType::circle;
+    shape->m_radius = i_radius;
+    shape->m_area = sfu::PI * i_radius * i_radius;
+    shape->m_unitInverseMomentOfInertia = 2.0f / (i_radius * i_radius);
+    shape->m_boundingRadius = i_radius; // Independent of the resolution
+
+    // Go along the circle's border and calculate the points for rendering
+    for (int i = 0; i < i_resolution; i++) {
+        float angle = 2 * sfu::PI * i / i_resolution;
+        shape->m_vertices.push_back(sfu::scaleVector(sf::Vector2f(std::cos(angle), std::sin(angle)), i_radius));
+    }
+    return shape;
+}
+
+/**
+ * @brief Create the definition of a straight line along the x-axis, as used by BoundaryElement. It has no area and a single normal
+ * pointing in positive y-direction.
+ * @param i_length Length of the line in pixels.
+ * @return The shared definition.
+ */
+std::shared_ptr<const ShapeDefinition> ShapeDefinition::createSegment(float i_length) {
+    COLLISION2D_MEMORY_SCOPE(memorySubsystem::shapes);
+    std::shared_ptr<ShapeDefinition> shape(new ShapeDefinition());
+    shape->m_type = shapeType::segment;
+    shape->m_vertices.push_back(sf::Vector2f(-i_length / 2, 0.0f));
+    shape->m_vertices.push_back(sf::Vector2f(i_length / 2, 0.0f));
+    shape->m_normals.push_back(sf::Vector2f(0.0f, 1.0f));
+    shape->calculateBoundingRadius();
+    return shape;
+}
+
+shapeType ShapeDefinition::getType() const {
+    return m_type;
+}
+
+vertexSpan ShapeDefinition::getVertices() const {
+    return m_vertices.getSpan();
+}
+
+vertexSpan ShapeDefinition::getNormals() const {
+    return m_normals.getSpan();
+}
+
+float ShapeDefinition::getArea() const {
+    return m_area;
+}
+
+sf::Vector2f ShapeDefinition::getCenterOfMass() const {
+    return m_centerOfMass;
+}
+
+float ShapeDefinition::getUnitInverseMomentOfInertia() const {
+    return m_unitInverseMomentOfInertia;
+}
+
+float ShapeDefinition::getBoundingRadius() const {
+    return m_boundingRadius;
+}
+
+float ShapeDefinition::getRadius() const {
+    return m_radius;
+}
+
+/**
+ * @brief Calculate the signed area of a polygon using the shoelace formula.
+ * @param i_vertices The corners of the polygon.
+ * @return The signed area given in pixel^2.
+ */
+float ShapeDefinition::calculateSignedArea(const std::vector<sf::Vector2f> & i_vertices) {
+    size_t numberOfVertices = i_vertices.size();
+
+    if (numberOfVertices < 3) {
+        return 0.0f; // A polygon must have at least 3 vertices
+    }
+    float area = 0.0f;
+
+    for (size_t i = 0; i < numberOfVertices; i++) {
+        // Current vertex
+        const sf::Vector2f & current = i_vertices[i];
+        // Next vertex (wrapping around at the end)
+        const sf::Vector2f & next = i_vertices[(i + 1) % numberOfVertices];
+
+        // Add cross-product to the area sum
+        area += current.x * next.y - current.y * next.x;
+    }
+
+    return area / 2.0f;
+}
+
+/**
+ * @brief Calculate the center of mass of a polygon.
+ * @param i_vertices The corners of the polygon.
+ * @return The coordinates of the center of mass relative to {0.0,0.0}.
+ */
+sf::Vector2f ShapeDefinition::calculateCenterOfMass(const std::vector<sf::Vector2f> & i_vertices) {
+    size_t numberOfVertices = i_vertices.size();
+    if (numberOfVertices < 3) {
+        return sf::Vector2f(0.0f, 0.0f); // A polygon must have at least 3 vertices
+    }
+
+    float signedArea = calculateSignedArea(i_vertices);
+    float cx = 0.0f, cy = 0.0f;
+
+    for (size_t i = 0; i < numberOfVertices; ++i) {
+        const sf::Vector2f & current = i_vertices[i];
+        const sf::Vector2f & next = i_vertices[(i + 1) % numberOfVertices];
+
+        float crossProduct = current.x * next.y - next.x * current.y;
+        cx += (current.x + next.x) * crossProduct;
+        cy += (current.y + next.y) * crossProduct;
+    }
+
+    cx /= (6.0f * signedArea);
+    cy /= (6.0f * signedArea);
+
+    return sf::Vector2f(cx, cy);
+}
+
+/**
+ * @brief Calculate the inverse moment of inertia of a polygon with unit mass.
+ * @param i_vertices The corners of the polygon, relative to the center of mass.
+ * @return The inverse moment of inertia measured in 1/pixel^2.
+ */
+float ShapeDefinition::calculateUnitInverseMomentOfInertia(vertexSpan i_vertices) {
+    if (i_vertices.size < 3) {
+        return 0.0f; // A polygon needs at least 3 points
+    }
+    float numerator = 0.0f;
+    float denominator = 0.0f;
+    std::size_t n = i_vertices.size;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        std::size_t j = (i + 1) % n; // Next vertex index (wrap around)
+        float xi = i_vertices[i].x;
+        float yi = i_vertices[i].y;
+        float xj = i_vertices[j].x;
+        float yj = i_vertices[j].y;
+
+        float commonTerm = std::abs(xi * yj - xj * yi);
+        numerator += (xi * xi + xi * xj + xj * xj + yi * yi + yi * yj + yj * yj) * commonTerm;
+        denominator += commonTerm;
+    }
+
+    float moi = numerator / (denominator * 6.0f);
+    return 1.0f / std::abs(moi);
+}
+
+/**
+ * @brief Calculate m_boundingRadius from the vertices.
+ */
+void ShapeDefinition::calculateBoundingRadius() {
+    m_boundingRadius = 0.0f;
+    for (const sf::Vector2f & vertex : m_vertices.getSpan()) {
+        m_boundingRadius = std::max(m_boundingRadius, sfu::getVectorLength(vertex));
+    }
+}
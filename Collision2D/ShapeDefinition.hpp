@@ -0,0 +1,77 @@
+#pragma once
+
+#include "InlineVertexArray.hpp"
+#include <SFML/System/Vector2.hpp>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief The kinds of geometry a ShapeDefinition can describe.
+ */
+enum class shapeType {
+    polygon, ///< Convex polygon with at least 3 vertices (Polygon).
+    circle,  ///< Circle, its vertices are only used for rendering (Circle).
+    segment  ///< Straight line with a single normal (BoundaryElement).
+};
+
+/**
+ * @class ShapeDefinition
+ * @brief Immutable geometry of a body, shared by all bodies with the same shape (flyweight).
+ *
+ * Everything that only depends on the shape is calculated once when the definition is created: vertices relative to the center of mass,
+ * edge normals, area, moment of inertia and bounding radius. Creating a body from an existing definition only copies a pointer, so scenes
+ * with thousands of identical bodies should create the definition once and pass it to every body.
+ *
+ * Vertices and normals of shapes with up to InlineVertexArray::INLINE_CAPACITY corners are stored inside the definition, so reading a shape
+ * only touches a single block of memory.
+ *
+ * The moment of inertia is stored for a body of unit mass. A body multiplies it with its own inverse mass, so bodies with different masses
+ * can share a definition.
+ */
+class ShapeDefinition {
+  public:
+    // Factory methods
+    static std::shared_ptr<const ShapeDefinition> createPolygon(const std::vector<sf::Vector2f> & i_vertices);
+    static std::shared_ptr<const ShapeDefinition> createCircle(float i_radius, int i_resolution = DEFAULT_CIRCLE_RESOLUTION);
+    static std::shared_ptr<const ShapeDefinition> createSegment(float i_length);
+
+    // Getters
+    shapeType getType() const;
+    vertexSpan getVertices() const;
+    vertexSpan getNormals() const;
+    float getArea() const;
+    sf::Vector2f getCenterOfMass() const;
+    float getUnitInverseMomentOfInertia() const;
+    float getBoundingRadius() const;
+    float getRadius() const;
+
+    /// Number of rendered vertices of a circle (only changes appearance, doesn't influence the physical behaviour).
+    static constexpr int DEFAULT_CIRCLE_RESOLUTION = 12;
+
+  private:
+    // Constructor, use the factory methods
+    ShapeDefinition();
+
+    // Private methods
+    static float calculateSignedArea(const std::vector<sf::Vector2f> & i_vertices);
+    static sf::Vector2f calculateCenterOfMass(const std::vector<sf::Vector2f> & i_vertices);
+    static float calculateUnitInverseMomentOfInertia(vertexSpan i_vertices);
+    void calculateBoundingRadius();
+
+    // Member variables
+    shapeType m_type = shapeType::polygon;
+    /// Corners of the shape in body coordinates, i.e. relative to the center of mass. For a Circle, they are only used for rendering.
+    InlineVertexArray m_vertices;
+    /// Outward normal of every edge in body coordinates. Empty for circles.
+    InlineVertexArray m_normals;
+    /// Measured in pixel^2.
+    float m_area = 0.0f;
+    /// Center of mass of the vertices that were passed in, before they were moved to put it at {0,0}.
+    sf::Vector2f m_centerOfMass = sf::Vector2f(0.0f, 0.0f);
+    /// Inverse moment of inertia of a body with unit mass, measured in 1/pixel^2. Zero for shapes without an area.
+    float m_unitInverseMomentOfInertia = 0.0f;
+    /// Radius of the smallest circle around the center of mass which contains the whole shape, in pixels.
+    float m_boundingRadius = 0.0f;
+    /// Radius of a circle in pixels. Zero for all other shapes.
+    float m_radius = 0.0f;
+};
@@ -1,8 +1,9 @@
 #include "Simulation.hpp"
 #include "CollisionDetector.hpp"
-#include "iostream"
+#include "Polygon.hpp"
 #include "stdlib.h"
 #include "sfml_utility.hpp"
+#include <algorithm>
 
 std::unique_ptr<Simulation> Simulation::s_instance = nullptr; // pointer to Singleton instance
 std::mutex Simulation::mtx;
@@ -22,11 +23,14 @@ Simulation & Simulation::getInstance() {
     return *s_instance;
 }
 
-Simulation::Simulation() {}
+Simulation::Simulation() {
+    m_profiler.setTraceRecorder(&m_traceRecorder);
+    m_workerPool.setTraceRecorder(&m_traceRecorder);
+}
 
 Simulation::~Simulation() {
     // Clean up all the members to avoid memory leaks
-    cleanupMember(m_bodiesToSimulate);
+    m_bodiesToSimulate.clear();
     cleanupMember(m_players);
 
     // Properly close the render window
@@ -48,6 +52,40 @@ template <typename T> inline void Simulation::cleanupMember(std::vector<T *> & m
     member.clear();
 }
 
+/**
+ * @brief Statistics of the last frame, e.g. the number of contacts.
+ * @return The statistics.
+ */
+const simulationStats & Simulation::getStats() const {
+    return m_stats;
+}
+
+/**
+ * @brief Timing statistics of the phases of the last frames.
+ * @return The profiler.
+ */
+const Profiler & Simulation::getProfiler() const {
+    return m_profiler;
+}
+
+/**
+ * @brief Records the frames, their phases and the jobs of the worker threads. Start it to capture the next frames, then write the capture
+ * with TraceRecorder::writeChromeTrace() and open it in chrome://tracing or https://ui.perfetto.dev.
+ * @return The trace recorder.
+ */
+TraceRecorder & Simulation::getTraceRecorder() {
+    return m_traceRecorder;
+}
+
+/**
+ * @brief Writes a report with the phase times, counters and a snapshot of the world for every step (or frame, when the window is open)
+ * which takes longer than a time budget. Set a budget with SlowStepRecorder::setBudget() to enable it.
+ * @return The slow step recorder.
+ */
+SlowStepRecorder & Simulation::getSlowStepRecorder() {
+    return m_slowStepRecorder;
+}
+
 /**
  * @brief Opens the window and starts running the simulation.
  *
@@ -63,22 +101,70 @@ void Simulation::run() {
         while (m_clock.getElapsedTime().asSeconds() < m_dT) {} // wait until m_dT is elapsed
         update();
         m_clock.restart();
-        handleEvents(); // HandleEvents is last because it calls the destructor if the window is closed
+        handleEvents(); // Last, so the loop ends right after the window has been closed
     }
 }
 
 /**
  * @brief Add a new body to the simulation.
  *
- * The body is pushed back to m_collisionPartners and the appearance is set.
+ * The simulation takes ownership of the body. If this is called during a step (e.g. from m_collisionCallback), the body is added at the
+ * end of the step.
  *
- * @param i_collisionPartner A pointer to the object that needs to be added.
+ * @param i_collisionPartner A pointer to the object that needs to be added. Must have been allocated with new.
+ * @return The handle of the body.
  */
-void Simulation::addCollisionPartner(RigidBody * i_collisionPartner) {
-    m_bodiesToSimulate.push_back(i_collisionPartner);
-    i_collisionPartner->setOutlineColor(sf::Color::Red);
-    i_collisionPartner->setFillColor(sf::Color::Black);
-    i_collisionPartner->setOutlineThickness(-2.0f);
+bodyHandle Simulation::addCollisionPartner(RigidBody * i_collisionPartner) {
+    COLLISION2D_MEMORY_SCOPE(memorySubsystem::bodies);
+    return m_bodiesToSimulate.insert(i_collisionPartner);
+}
+
+/**
+ * @brief Create many bodies at once, e.g. to load a scene.
+ *
+ * Memory for all bodies is reserved up front, so the bodies are created without any reallocation. Bodies sharing a ShapeDefinition don't
+ * calculate any geometry.
+ *
+ * @param i_definitions Shape and initial state of every body. Segment definitions are skipped, use addBoundaryElement() for them.
+ * Definitions without a shape are skipped as well.
+ * @return The handles of the bodies in the same order as the definitions. Skipped definitions get an invalid handle.
+ */
+std::vector<bodyHandle> Simulation::createCollisionPartners(const std::vector<bodyDefinition> & i_definitions) {
+    COLLISION2D_MEMORY_SCOPE(memorySubsystem::bodies);
+    std::size_t circleCount = 0;
+    std::size_t polygonCount = 0;
+    for (const bodyDefinition & definition : i_definitions) {
+        if (definition.shape == nullptr) {
+            continue;
+        } else if (definition.shape->getType() == shapeType::circle) {
+            circleCount++;
+        } else if (definition.shape->getType() == shapeType::polygon) {
+            polygonCount++;
+        }
+    }
+    m_bodiesToSimulate.reserve<Circle>(circleCount);
+    m_bodiesToSimulate.reserve<Polygon>(polygonCount);
+    m_stepBodies.reserve(m_bodiesToSimulate.size() + circleCount + polygonCount + m_players.size());
+
+    std::vector<bodyHandle> handles(i_definitions.size());
+    for (std::size_t i = 0; i < i_definitions.size(); i++) {
+        const bodyDefinition & definition = i_definitions[i];
+        if (definition.shape == nullptr) {
+            continue;
+        } else if (definition.shape->getType() == shapeType::circle) {
+            handles[i] = m_bodiesToSimulate.create<Circle>(definition.inverseMass, definition.shape);
+        } else if (definition.shape->getType() == shapeType::polygon) {
+            handles[i] = m_bodiesToSimulate.create<Polygon>(definition.inverseMass, definition.shape);
+        } else {
+            continue;
+        }
+        RigidBody * body = m_bodiesToSimulate.get(handles[i]);
+        body->setPosition(definition.position);
+        body->setVelocity(definition.velocity);
+        body->setOrientation(definition.orientation);
+        body->setAngularVelocityRadians(definition.angularVelocity);
+    }
+    return handles;
 }
 
 /**
@@ -90,35 +176,45 @@ void Simulation::addPlayer(PlayerController * i_playerController) {
     m_players.push_back(i_playerController);
 }
 
+/**
+ * @brief Look up a body of the simulation.
+ * @param i_handle The handle returned by addCollisionPartner() or createCollisionPartner().
+ * @return The body, or nullptr if it has been deleted.
+ */
+RigidBody * Simulation::getCollisionPartner(bodyHandle i_handle) const {
+    return m_bodiesToSimulate.get(i_handle);
+}
+
+/**
+ * @brief Removes a body from the simulation in constant time.
+ *
+ * Safe to call during a step (e.g. from m_collisionCallback): the body is then only queued, and all queued bodies are removed together at
+ * the end of the step. Until then, the body is still simulated and its handle stays valid.
+ *
+ * @param i_handle The handle of the body that needs to be deleted. Nothing happens if the body has already been deleted.
+ */
+void Simulation::deleteCollisionPartner(bodyHandle i_handle) {
+    m_bodiesToSimulate.remove(i_handle);
+}
+
 /**
  * @brief Removes a body from the simulation.
  *
+ * @note The last body takes the place of the deleted one, so the indices of the other bodies may change.
+ *
  * @param i_index The index of the body that needs to be deleted.
  */
 void Simulation::deleteCollisionPartner(int i_index) {
-    // Retrieve body pointer
-    RigidBody * colParToDelete = m_bodiesToSimulate[i_index];
-    // Delete body
-    delete colParToDelete;
-    // Remove pointer from vector
-    m_bodiesToSimulate.erase(m_bodiesToSimulate.begin() + i_index);
+    m_bodiesToSimulate.remove(m_bodiesToSimulate.getHandle(i_index));
 }
 
 /**
- * @brief Removes a body from the simulation.
+ * @brief Removes a body from the simulation. Prefer the handle based overload, which doesn't have to search for the body.
  *
  * @param i_bodyToDelete Pointer to the body that needs to be deleted.
  */
 void Simulation::deleteCollisionPartner(RigidBody * i_bodyToDelete) {
-    for (int i = 0; i < m_bodiesToSimulate.size(); i++) {
-        // First check if the body is even part of the simulation
-        if (m_bodiesToSimulate[i] == i_bodyToDelete) {
-            // Delete body
-            delete m_bodiesToSimulate[i];
-            // Remove pointer from vector
-            m_bodiesToSimulate.erase(m_bodiesToSimulate.begin() + i);
-        }
-    }
+    m_bodiesToSimulate.remove(i_bodyToDelete);
 }
 
 /**
@@ -183,62 +279,266 @@ void Simulation::addBoundaryElement(BoundaryElement * i_boundaryElement) {
 }
 
 /**
- * @brief Updates the window, bodies and collisions.
+ * @brief Remove a boundary element from the simulation. The element is not deleted, it still belongs to the caller.
  *
- * This method is called every frame. Checks for collisions and resolves them by calling other methods. Updates body positions. Generates
- * CollisionEvents for all possible combinations of bodies. If a collision is detected, it is resolved. If the window has been resized, the
- * view is updated accordingly. The change in position and rotation is applied and displayed for all bodies.
+ * @param i_boundaryElement A pointer to the boundary element that needs to be removed. Nothing happens if it isn't part of the simulation.
+ */
+void Simulation::removeBoundaryElement(BoundaryElement * i_boundaryElement) {
+    m_boundaryElements.erase(
+            std::remove(m_boundaryElements.begin(), m_boundaryElements.end(), i_boundaryElement), m_boundaryElements.end());
+}
+
+/**
+ * @brief Updates the window, bodies and collisions.
  *
- * @param i_player A pointer to the boundary element that needs to be added.
+ * This method is called every frame. Advances the physics by one time step (see step()) and displays the bodies. If the window has been
+ * resized, the view is updated accordingly.
  */
 void Simulation::update() {
+    takeSlowStepSnapshot();
+    Profiler::clock::time_point frameStart = Profiler::clock::now();
+    // Wall-clock time of the previous frame, from its start to the start of this one. Covers everything, including the overlay itself.
+    float lastFrameTime = 0.0f;
+    if (m_lastFrameStart != Profiler::clock::time_point()) {
+        lastFrameTime = std::chrono::duration<float, std::micro>(frameStart - m_lastFrameStart).count();
+    }
+    m_lastFrameStart = frameStart;
     m_window.setView(m_view); // update view
     m_window.clear();         // remove old Objects
-    
-    std::vector<RigidBody *> playerBodies;
 
+    simulate(m_dT);
+
+    // Render the frame
+    {
+        COLLISION2D_PROFILE_SCOPE(m_profiler, profilePhase::render);
+        COLLISION2D_MEMORY_SCOPE(memorySubsystem::rendering);
+        drawBodies();
+    }
+    // The overlay isn't part of any phase, so it doesn't inflate the render time it shows
+    if (m_showPerformanceHud) {
+        COLLISION2D_MEMORY_SCOPE(memorySubsystem::rendering);
+        m_performanceHud.update(m_profiler, m_stats, lastFrameTime, m_dT * 1e6f);
+        m_performanceHud.draw(m_window);
+    }
+    {
+        COLLISION2D_PROFILE_SCOPE(m_profiler, profilePhase::render);
+        m_window.display();
+    }
+    // The events are handled after the frame (see run()), so they are counted in the next frame of the profiler
+    m_profiler.endFrame();
+    recordSlowStep(frameStart, m_dT);
+}
+
+/**
+ * @brief Advances the physics by one time step without rendering anything.
+ *
+ * Generates CollisionEvents for all candidate pairs of bodies (see collectCandidatePairs()). The detected collisions are collected first
+ * and then resolved by the ContactSolver, which distributes them across multiple threads. Bodies which would collide within the time step
+ * get a speculative contact (see m_useSpeculativeContacts). Afterwards, the change in position and rotation is applied to all bodies.
+ * Bullets are moved last with continuous collision detection.
+ *
+ * Every call is a frame of the profiler (see getProfiler()).
+ *
+ * @param i_dT Time increment in seconds.
+ */
+void Simulation::step(float i_dT) {
+    takeSlowStepSnapshot();
+    Profiler::clock::time_point stepStart = Profiler::clock::now();
+    simulate(i_dT);
+    m_profiler.endFrame();
+    recordSlowStep(stepStart, i_dT);
+}
+
+/**
+ * @brief Copy the state of all bodies and BoundaryElements into the SlowStepRecorder before a step, so a slow step can be reported with
+ * the state it started from. Does nothing while no budget is set. Not part of the measured step time.
+ */
+void Simulation::takeSlowStepSnapshot() {
+    if (!m_slowStepRecorder.isRecording()) {
+        return;
+    }
+    m_slowStepRecorder.startSnapshot();
+    for (const RigidBody * body : m_bodiesToSimulate.getBodies()) {
+        m_slowStepRecorder.addToSnapshot(*body);
+    }
     for (PlayerController * player : m_players) {
-        playerBodies.push_back(player->getPlayerBody());
+        m_slowStepRecorder.addToSnapshot(*player->getPlayerBody());
     }
+    for (const BoundaryElement * boundaryElement : m_boundaryElements) {
+        m_slowStepRecorder.addToSnapshot(*boundaryElement);
+    }
+}
 
-    // Create a new vector to hold combined contents
-    std::vector<RigidBody *> allBodies;
-    allBodies.reserve(m_bodiesToSimulate.size() + m_players.size()); // Reserve memory to improve performance
+/**
+ * @brief Write a report of the step that just ended, if it took longer than the budget of the SlowStepRecorder.
+ * @param i_stepStart When the step started.
+ * @param i_dT The time step in seconds.
+ */
+void Simulation::recordSlowStep(Profiler::clock::time_point i_stepStart, float i_dT) {
+    float stepTime = std::chrono::duration<float>(Profiler::clock::now() - i_stepStart).count();
+    if (!m_slowStepRecorder.isOverBudget(stepTime)) {
+        return;
+    }
+    m_slowStepRecorder.record(stepTime, i_dT, m_profiler, m_stats);
+}
 
-    // Copy the relevant content into allBodies
-    allBodies.insert(allBodies.end(), m_bodiesToSimulate.begin(), m_bodiesToSimulate.end());
-    allBodies.insert(allBodies.end(), playerBodies.begin(), playerBodies.end());
-    // Iterate through all bodies
-    for (int i = 0; i < allBodies.size(); i++) {
-        // Iterate through all potential partners (only lower indices are used to avoid the same collision being processed twice)
-        for (int j = 0; j < i; j++) {
-            CollisionEvent collEvent = m_cd.generateCollisionEvent(allBodies[j], allBodies[i]);
-            evaluateCollisionEvent(collEvent);
+/**
+ * @brief Advances the physics by one time step, see step().
+ * @param i_dT Time increment in seconds.
+ */
+void Simulation::simulate(float i_dT) {
+    std::uint64_t allocationCount = AllocationTracker::getAllocationCount();
+    // Everything in the arena belongs to the previous step
+    m_frameArena.reset();
+    // Collect all bodies of this step. m_stepBodies keeps its capacity, so no memory is allocated once the number of bodies has settled.
+    std::vector<RigidBody *> & allBodies = m_stepBodies;
+    allBodies.clear();
+    allBodies.insert(allBodies.end(), m_bodiesToSimulate.getBodies().begin(), m_bodiesToSimulate.getBodies().end());
+    for (PlayerController * player : m_players) {
+        allBodies.push_back(player->getPlayerBody());
+    }
+    m_stats.bodyCount = allBodies.size();
+    m_stats.speculativeContactCount = 0;
+    m_stats.integratedBodyCount = 0;
+    m_cd.resetCounters();
+    // Bodies added or deleted from now on are queued, so the body list stays valid until the end of the step
+    m_bodiesToSimulate.deferChanges();
+    {
+        COLLISION2D_PROFILE_SCOPE(m_profiler, profilePhase::broadphase);
+        COLLISION2D_MEMORY_SCOPE(memorySubsystem::broadphase);
+        collectCandidatePairs(allBodies);
+    }
+
+    // Narrowphase: run the collision detection for all candidate pairs
+    {
+        COLLISION2D_MEMORY_SCOPE(memorySubsystem::contacts);
+        m_contactSolver.beginStep(m_frameArena, allBodies.size());
+    }
+    {
+        COLLISION2D_PROFILE_SCOPE(m_profiler, profilePhase::narrowphase);
+        COLLISION2D_MEMORY_SCOPE(memorySubsystem::contacts);
+        for (const candidatePair & pair : m_candidatePairs) {
+            CollisionEvent collEvent = detectCollision(pair.firstBody, allBodies[pair.secondBodyIndex], i_dT);
+            evaluateCollisionEvent(collEvent, pair.firstBodyIndex, pair.secondBodyIndex);
+            if (m_collisionCallback && !collEvent.isSpeculative() && collEvent.getMinSeparation() <= 0) {
+                m_collisionCallback(pair.firstBody, allBodies[pair.secondBodyIndex]);
+            }
         }
-        // Iterate through all boundaryElements
-        for (int j = 0; j < m_boundaryElements.size(); j++) {
-            CollisionEvent collEvent = m_cd.generateCollisionEvent(m_boundaryElements[j], allBodies[i]);
-            evaluateCollisionEvent(collEvent);
+    }
+    // Bullets run the collision detection again later, which must not count as narrowphase work
+    m_stats.narrowphase = m_cd.getCounters();
+    // Resolve all detected collisions
+    {
+        COLLISION2D_PROFILE_SCOPE(m_profiler, profilePhase::solve);
+        COLLISION2D_MEMORY_SCOPE(memorySubsystem::contacts);
+        m_contactSolver.solve(m_workerPool);
+    }
+    m_stats.contactCount = m_contactSolver.getContactCount();
+    m_stats.colorCount = m_contactSolver.getColorCount();
+    m_stats.degenerateContactCount = m_contactSolver.getDegenerateContactCount();
+    m_stats.totalDegenerateContactCount += m_stats.degenerateContactCount;
+    m_stats.resolvedContactCount = m_contactSolver.getResolvedContactCount();
+    m_stats.impulseCount = m_stats.resolvedContactCount;
+    m_stats.frameArenaUsedBytes = m_frameArena.getUsedBytes();
+    m_stats.frameArenaHighWaterMark = m_frameArena.getHighWaterMark();
+    m_stats.frameArenaCapacity = m_frameArena.getCapacity();
+
+    {
+        COLLISION2D_PROFILE_SCOPE(m_profiler, profilePhase::integrate);
+        updateBodies(i_dT);
+        advanceBullets(allBodies, i_dT);
+    }
+
+    // Safe point: add and remove the bodies queued during the step in one pass
+    {
+        COLLISION2D_MEMORY_SCOPE(memorySubsystem::bodies);
+        m_bodiesToSimulate.applyDeferredChanges();
+    }
+    m_stats.allocationCount = static_cast<std::size_t>(AllocationTracker::getAllocationCount() - allocationCount);
+}
+
+/**
+ * @brief Calls the update method for all simulated RigidBodies except for bullets.
+ * @param i_dT Time increment in seconds.
+ */
+void Simulation::updateBodies(float i_dT) {
+    for (RigidBody * body : m_bodiesToSimulate.getBodies()) {
+        if (!body->isBullet()) {
+            body->updateBody(i_dT);
+            m_stats.integratedBodyCount++;
         }
     }
 
-    // Render the frame
-    updateAndDrawBodies();
-    m_window.display();
+    for (PlayerController * player : m_players) {
+        player->update(i_dT);
+        m_stats.integratedBodyCount++;
+    }
+}
+
+/**
+ * @brief Moves all bullets ahead with continuous collision detection, so they can't tunnel through other bodies.
+ *
+ * The other bodies have already been moved at this point and are treated as resting. A bullet is moved to the earliest time of impact,
+ * the collision is resolved and the bullet continues with the remaining time. If it hits more than MAX_BULLET_SUBSTEPS bodies in a single
+ * time step, the rest of the time step is dropped for this bullet.
+ *
+ * @param i_allBodies All bodies of the current step, including the player bodies.
+ * @param i_dT Time increment in seconds.
+ */
+void Simulation::advanceBullets(const std::vector<RigidBody *> & i_allBodies, float i_dT) {
+    m_stats.bulletImpactCount = 0;
+    for (RigidBody * bullet : m_bodiesToSimulate.getBodies()) {
+        if (!bullet->isBullet()) {
+            continue;
+        }
+        m_stats.integratedBodyCount++;
+        float remainingTime = i_dT;
+        for (int substep = 0; substep < MAX_BULLET_SUBSTEPS; substep++) {
+            // Find the first body the bullet would hit
+            impactData firstImpact;
+            RigidBody * firstObstacle = nullptr;
+            auto checkObstacle = [&](RigidBody * i_obstacle) {
+                impactData impact = m_cd.calculateTimeOfImpact(bullet, i_obstacle, remainingTime);
+                if (impact.hasImpact && (firstObstacle == nullptr || impact.time < firstImpact.time)) {
+                    firstImpact = impact;
+                    firstObstacle = i_obstacle;
+                }
+            };
+            for (RigidBody * body : i_allBodies) {
+                if (body != bullet) {
+                    checkObstacle(body);
+                }
+            }
+            for (BoundaryElement * element : m_boundaryElements) {
+                checkObstacle(element);
+            }
+
+            if (firstObstacle == nullptr) {
+                bullet->updateBody(remainingTime);
+                break;
+            }
+            // Move to the point of impact and bounce off
+            bullet->updateBody(firstImpact.time);
+            CollisionEvent collEvent(bullet, firstObstacle, firstImpact.geometry);
+            if (collEvent.resolve() == resolveResult::resolved) {
+                m_stats.impulseCount++;
+            }
+            remainingTime -= firstImpact.time;
+            m_stats.bulletImpactCount++;
+        }
+    }
 }
 
 /**
- * @brief Calls the update method for all simulated RigidBodies and draws them into the new frame.
+ * @brief Draws all bodies into the new frame.
  */
-void Simulation::updateAndDrawBodies() {
-    for (RigidBody * body : m_bodiesToSimulate) {
-        body->updateBody(m_dT);
-        m_window.draw(*body);
+void Simulation::drawBodies() {
+    for (RigidBody * body : m_bodiesToSimulate.getBodies()) {
+        m_bodyRenderer.draw(m_window, *body);
     }
 
     for (PlayerController * player : m_players) {
-        player->update(m_dT);
-        m_window.draw(*(player->getPlayerBody()));
+        m_bodyRenderer.draw(m_window, *(player->getPlayerBody()));
     }
 
     // Update and display collision geometry markers
@@ -250,23 +550,70 @@ void Simulation::updateAndDrawBodies() {
 
     // Update and display boundaryElements
     for (BoundaryElement * element : m_boundaryElements) {
-        sf::Vertex * vertexArray = element->getVertexArray();
-        // Copy the content into a local array
-        sf::Vertex localVertexArray[2];
-        localVertexArray[0] = vertexArray[0];
-        localVertexArray[1] = vertexArray[1];
-        m_window.draw(localVertexArray, 2, sf::Lines);
+        m_bodyRenderer.drawBoundary(m_window, *element);
     }
 }
 
 /**
- * @brief Checks if the CollisionEvent actually indicates a collision. Calls the resolve() method, updates position and angle of the
- * collision geometry markers.
+ * @brief Collects all pairs of bodies that need to be checked for a collision in m_candidatePairs.
+ *
+ * Every pair of bodies is a candidate, as well as every combination of a body and a BoundaryElement. Pairs of static bodies are skipped,
+ * as they can't do anything about a collision. The pairs are stored in the frame arena.
+ *
+ * @param i_allBodies All bodies of the current step, including the player bodies.
+ */
+void Simulation::collectCandidatePairs(const std::vector<RigidBody *> & i_allBodies) {
+    m_candidatePairs.reset(m_frameArena);
+    m_stats.skippedStaticPairCount = 0;
+    for (int i = 0; i < i_allBodies.size(); i++) {
+        // Only lower indices are used to avoid the same pair being processed twice
+        for (int j = 0; j < i; j++) {
+            if (i_allBodies[j]->isStatic() && i_allBodies[i]->isStatic()) {
+                m_stats.skippedStaticPairCount++;
+                continue;
+            }
+            m_candidatePairs.push_back({i_allBodies[j], j, i});
+        }
+        for (BoundaryElement * element : m_boundaryElements) {
+            if (element->isStatic() && i_allBodies[i]->isStatic()) {
+                m_stats.skippedStaticPairCount++;
+                continue;
+            }
+            m_candidatePairs.push_back({element, ContactSolver::STATIC_BODY, i});
+        }
+    }
+    m_stats.testedPairCount = m_candidatePairs.size();
+}
+
+/**
+ * @brief Runs the collision detection for a pair of bodies.
+ * @param i_firstBody One of the bodies.
+ * @param i_secondBody The other body.
+ * @param i_dT Time increment in seconds, needed for speculative contacts.
+ * @return The CollisionEvent, including speculative contacts if m_useSpeculativeContacts is set.
+ */
+CollisionEvent Simulation::detectCollision(RigidBody * i_firstBody, RigidBody * i_secondBody, float i_dT) {
+    if (m_useSpeculativeContacts) {
+        return m_cd.generateSpeculativeCollisionEvent(i_firstBody, i_secondBody, i_dT);
+    }
+    return m_cd.generateCollisionEvent(i_firstBody, i_secondBody);
+}
+
+/**
+ * @brief Checks if the CollisionEvent actually indicates a collision. Hands it over to the ContactSolver, updates position and angle of
+ * the collision geometry markers.
  *
  * @param i_collisionEvent The CollisionEvent to evaluate.
+ * @param i_firstBodyIndex Index of the first collision partner in the body list of the current frame (ContactSolver::STATIC_BODY for
+ * BoundaryElements).
+ * @param i_secondBodyIndex Index of the second collision partner in the body list of the current frame.
  */
-void Simulation::evaluateCollisionEvent(CollisionEvent & i_collisionEvent) {
-    if (i_collisionEvent.getMinSeparation() <= 0) {
+void Simulation::evaluateCollisionEvent(CollisionEvent & i_collisionEvent, int i_firstBodyIndex, int i_secondBodyIndex) {
+    if (i_collisionEvent.isSpeculative()) {
+        // The bodies don't touch yet, so there is nothing to mark
+        m_contactSolver.addContact(i_collisionEvent, i_firstBodyIndex, i_secondBodyIndex);
+        m_stats.speculativeContactCount++;
+    } else if (i_collisionEvent.getMinSeparation() <= 0) {
         collisionGeometry collisionGeometry = i_collisionEvent.getCollisionGeometry();
         if (m_showCollisionMarkers) {
             m_collisionLocationMarker.setPosition(collisionGeometry.location);
@@ -275,44 +622,52 @@ void Simulation::evaluateCollisionEvent(CollisionEvent & i_collisionEvent) {
             m_collisionNormalMarkers[0].setRotation(sfu::getVectorDirection(collisionGeometry.normals[0]));
             m_collisionNormalMarkers[1].setRotation(sfu::getVectorDirection(collisionGeometry.normals[0]));
         }
-        i_collisionEvent.resolve(); 
+        m_contactSolver.addContact(i_collisionEvent, i_firstBodyIndex, i_secondBodyIndex);
     }
 }
 
 /**
- * @brief Handle resizing and closing of the window by the user.
+ * @brief Handle resizing and closing of the window by the user. Closing the window ends run().
  */
 void Simulation::handleEvents() {
-    sf::Event event;
-    while (m_window.pollEvent(event)) {
-        sf::Vector2u newSize;
-
-        switch (event.type) {
-        case sf::Event::Closed:
-            Simulation::~Simulation(); // destroy Simulation; close window
-            break;
-        case sf::Event::Resized: // change window size and adapt view
-            m_view.setSize((float) m_window.getSize().x, (float) m_window.getSize().y); // adapt view size
-            m_view.setCenter(m_window.getSize().x / 2.0f, m_window.getSize().y / 2.0f); // adapt view center
-            break;
-        }
+    {
+        COLLISION2D_PROFILE_SCOPE(m_profiler, profilePhase::events);
+        sf::Event event;
+        while (m_window.pollEvent(event)) {
+            sf::Vector2u newSize;
 
-        // mouse control
-        if (sf::Mouse::isButtonPressed(sf::Mouse::Left)) {
-            sf::Vector2i mousePos = sf::Mouse::getPosition(m_window);
-            m_players[0]->getPlayerBody()->setPosition(static_cast<float>(mousePos.x), static_cast<float>(mousePos.y));
-        }
-        const float ROTATION_PER_TIMESTEP = 0.05f;
-        // Rotation control
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Q)) {
-            float oldRotation = m_players[0]->getPlayerBody()->getRotation();
-            float newRotation = oldRotation - ROTATION_PER_TIMESTEP;
-            m_players[0]->getPlayerBody()->setRotation(newRotation);
-        }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::E)) {
-            float oldRotation = m_players[0]->getPlayerBody()->getRotation();
-            float newRotation = oldRotation + ROTATION_PER_TIMESTEP;
-            m_players[0]->getPlayerBody()->setRotation(newRotation);
+            switch (event.type) {
+            case sf::Event::Closed:
+                m_window.close(); // run() returns, the Simulation is destroyed at the end of the program
+                break;
+            case sf::Event::Resized: // change window size and adapt view
+                m_view.setSize((float) m_window.getSize().x, (float) m_window.getSize().y); // adapt view size
+                m_view.setCenter(m_window.getSize().x / 2.0f, m_window.getSize().y / 2.0f); // adapt view center
+                break;
+            case sf::Event::KeyPressed:
+                if (event.key.code == sf::Keyboard::F1) {
+                    m_showPerformanceHud = !m_showPerformanceHud;
+                }
+                break;
+            }
+
+            // mouse control
+            if (sf::Mouse::isButtonPressed(sf::Mouse::Left)) {
+                sf::Vector2i mousePos = sf::Mouse::getPosition(m_window);
+                m_players[0]->getPlayerBody()->setPosition(static_cast<float>(mousePos.x), static_cast<float>(mousePos.y));
+            }
+            const float ROTATION_PER_TIMESTEP = 0.05f;
+            // Rotation control
+            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Q)) {
+                float oldRotation = m_players[0]->getPlayerBody()->getRotation();
+                float newRotation = oldRotation - ROTATION_PER_TIMESTEP;
+                m_players[0]->getPlayerBody()->setRotation(newRotation);
+            }
+            if (sf::Keyboard::isKeyPressed(sf::Keyboard::E)) {
+                float oldRotation = m_players[0]->getPlayerBody()->getRotation();
+                float newRotation = oldRotation + ROTATION_PER_TIMESTEP;
+                m_players[0]->getPlayerBody()->setRotation(newRotation);
+            }
         }
     }
 }
@@ -1,14 +1,54 @@
 #pragma once
 #include "sfml/Graphics.hpp"
 #include "VertexBasedBody.hpp"
+#include "BodyRenderer.hpp"
+#include "BodyStore.hpp"
 #include "CollisionDetector.hpp"
+#include "ContactSolver.hpp"
+#include "FrameArena.hpp"
+#include "SimulationStats.hpp"
+#include "Profiler.hpp"
+#include "AllocationTracker.hpp"
+#include "PerformanceHud.hpp"
+#include "SlowStepRecorder.hpp"
 #include "BoundaryElement.hpp"
 #include "PlayerController.hpp"
 #include <vector>
 #include <array>
+#include <functional>
 #include <mutex>
 #include <memory>
 
+/**
+ * @brief A pair of bodies that needs to be checked for a collision.
+ */
+struct candidatePair {
+    /// The first body, either one of the bodies of the current step or a BoundaryElement.
+    RigidBody * firstBody;
+    /// Index of the first body in the body list of the current step, or ContactSolver::STATIC_BODY for BoundaryElements.
+    int firstBodyIndex;
+    /// Index of the second body in the body list of the current step.
+    int secondBodyIndex;
+};
+
+/**
+ * @brief Everything needed to create a body with Simulation::createCollisionPartners().
+ */
+struct bodyDefinition {
+    /// The geometry. A circle definition creates a Circle, a polygon definition creates a Polygon.
+    std::shared_ptr<const ShapeDefinition> shape;
+    /// Put in zero for an immovable body.
+    float inverseMass = 0.1f;
+    /// Position of the center of mass in pixels.
+    sf::Vector2f position = sf::Vector2f(0.0f, 0.0f);
+    /// In pixels per second.
+    sf::Vector2f velocity = sf::Vector2f(0.0f, 0.0f);
+    /// In radians. Clockwise is positive!
+    float orientation = 0.0f;
+    /// In radians per second. Clockwise is positive!
+    float angularVelocity = 0.0f;
+};
+
 /**
  * @class Simulation
  * @brief A singleton class that manages the physics simulation, rendering, and event handling.
@@ -21,18 +61,36 @@ class Simulation {
     // Destructor
     ~Simulation();
 
+    // Getters
+    const simulationStats & getStats() const;
+    const Profiler & getProfiler() const;
+    TraceRecorder & getTraceRecorder();
+    SlowStepRecorder & getSlowStepRecorder();
+    RigidBody * getCollisionPartner(bodyHandle i_handle) const;
+
     // Public methods
     void addBoundaryElement(BoundaryElement * i_boundaryElement);
+    void removeBoundaryElement(BoundaryElement * i_boundaryElement);
     void initWindow(unsigned int i_viewWidth = DEFAULT_VIEW_WIDTH, unsigned int i_viewHeight = DEFAULT_VIEW_HEIGHT,
             float i_frameRate = DEFAULT_FRAME_RATE);
     void run();
-    void addCollisionPartner(RigidBody * i_collisionPartner);
+    void step(float i_dT);
+    bodyHandle addCollisionPartner(RigidBody * i_collisionPartner);
+    template <typename T, typename... Args> bodyHandle createCollisionPartner(Args &&... i_args);
+    std::vector<bodyHandle> createCollisionPartners(const std::vector<bodyDefinition> & i_definitions);
     void addPlayer(PlayerController * i_playerController);
+    void deleteCollisionPartner(bodyHandle i_handle);
     void deleteCollisionPartner(int i_index);
     void deleteCollisionPartner(RigidBody * i_bodyToDelete);
 
     /// Choose if you want to show collision geometry indicators
     bool m_showCollisionMarkers = true;
+    /// Show frame time, phase times and counters on top of the scene. Toggled with F1.
+    bool m_showPerformanceHud = false;
+    /// Generate speculative contacts for bodies which would collide within the time step, so fast bodies don't tunnel through thin ones
+    bool m_useSpeculativeContacts = true;
+    /// Called for every pair of touching bodies during step(). May add and delete bodies, which takes effect at the end of the step.
+    std::function<void(RigidBody * i_firstBody, RigidBody * i_secondBody)> m_collisionCallback;
 
   private:
     // Singleton implementation
@@ -46,25 +104,56 @@ class Simulation {
 
     // Private methods
     void update();
-    void updateAndDrawBodies();
-    void evaluateCollisionEvent(CollisionEvent & i_collisionEvent);
+    void simulate(float i_dT);
+    void takeSlowStepSnapshot();
+    void recordSlowStep(Profiler::clock::time_point i_stepStart, float i_dT);
+    void updateBodies(float i_dT);
+    void advanceBullets(const std::vector<RigidBody *> & i_allBodies, float i_dT);
+    void drawBodies();
+    void collectCandidatePairs(const std::vector<RigidBody *> & i_allBodies);
+    CollisionEvent detectCollision(RigidBody * i_firstBody, RigidBody * i_secondBody, float i_dT);
+    void evaluateCollisionEvent(CollisionEvent & i_collisionEvent, int i_firstBodyIndex, int i_secondBodyIndex);
     void handleEvents();
     void initCollisionMarkers();
     template <typename T> void cleanupMember(std::vector<T *> & member);
 
     // Member variables
     sf::Clock m_clock;
-    /// Vector of pointers to the bodies managed by the Simulation (does not include player controlled bodies)
-    std::vector<RigidBody *> m_bodiesToSimulate;
+    /// The bodies managed by the Simulation (does not include player controlled bodies)
+    BodyStore m_bodiesToSimulate;
     std::vector<PlayerController *> m_players; ///< Vector of pointers to the players
+    /// All bodies of the current step including the player bodies. Reused every step to avoid allocations.
+    std::vector<RigidBody *> m_stepBodies;
     // These shapes serve to visualize collision geometry
     sf::RectangleShape m_collisionLocationMarker{sf::RectangleShape({10.0f, 10.0f})};
     std::array<sf::RectangleShape, 2> m_collisionNormalMarkers{sf::RectangleShape(sf::Vector2f(50.0f, 1.0f)),
             sf::RectangleShape(sf::Vector2f(1.0f, 50.0f))};
+    /// Draws the bodies and BoundaryElements
+    BodyRenderer m_bodyRenderer;
     /// BoundaryElements get their own vector to avoid (nonsensical) collisions between them
     std::vector<BoundaryElement *> m_boundaryElements;
     /// Collision Detector instance
     CollisionDetector & m_cd = CollisionDetector::getInstance();
+    /// Holds the data that only lives for one step, e.g. candidate pairs and contacts. Reset at the beginning of every step.
+    FrameArena m_frameArena;
+    /// Pairs of bodies to check for collisions in the current step (in the frame arena).
+    FrameArray<candidatePair> m_candidatePairs;
+    /// Collects the contacts of a frame and resolves them in parallel
+    ContactSolver m_contactSolver;
+    /// Threads used by the contact solver
+    WorkerPool m_workerPool;
+    /// Statistics of the last frame
+    simulationStats m_stats;
+    /// Times of the phases of the last frames
+    Profiler m_profiler;
+    /// Records frames, phases and worker thread jobs for a timeline view once it has been started
+    TraceRecorder m_traceRecorder;
+    /// Overlay for the profiler and the statistics, see m_showPerformanceHud
+    PerformanceHud m_performanceHud;
+    /// Start of the last frame of update(), to measure the wall-clock frame time shown by the overlay
+    Profiler::clock::time_point m_lastFrameStart;
+    /// Writes a report of every step which exceeds the time budget, once a budget has been set
+    SlowStepRecorder m_slowStepRecorder;
     
     sf::View m_view;
     sf::RenderWindow m_window;
@@ -72,4 +161,20 @@ class Simulation {
     static constexpr unsigned int DEFAULT_VIEW_WIDTH = 512;  ///< In pixels.
     static constexpr unsigned int DEFAULT_VIEW_HEIGHT = 512; ///< In pixels.
     static constexpr float DEFAULT_FRAME_RATE = 120.0f;  ///< In Hz.
+    static constexpr int MAX_BULLET_SUBSTEPS = 4;        ///< Maximum number of impacts per bullet and time step.
 };
+
+/**
+ * @brief Construct a new body in the simulation's pooled memory and add it to the simulation.
+ *
+ * This is cheaper than allocating the body with new and calling addCollisionPartner(), especially if bodies are created and deleted all
+ * the time (e.g. projectiles).
+ *
+ * @tparam T The type of the body, e.g. Polygon or Circle.
+ * @param i_args Arguments passed to the constructor of T.
+ * @return The handle of the body.
+ */
+template <typename T, typename... Args> bodyHandle Simulation::createCollisionPartner(Args &&... i_args) {
+    COLLISION2D_MEMORY_SCOPE(memorySubsystem::bodies);
+    return m_bodiesToSimulate.create<T>(std::forward<Args>(i_args)...);
+}
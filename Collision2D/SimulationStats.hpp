@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+
+/**
+ * @brief Work done by the CollisionDetector, see CollisionDetector::getCounters().
+ */
+struct narrowphaseCounters {
+    /// Collision checks of two polygons.
+    std::size_t polygonPolygonCount = 0;
+    /// Collision checks of a polygon and a circle.
+    std::size_t polygonCircleCount = 0;
+    /// Collision checks of two circles.
+    std::size_t circleCircleCount = 0;
+    /// Collision checks of a segment (BoundaryElement) and a polygon or another segment.
+    std::size_t segmentPolygonCount = 0;
+    /// Collision checks of a segment (BoundaryElement) and a circle.
+    std::size_t segmentCircleCount = 0;
+    /// Number of separating axes (edge normals) tested by the SAT.
+    std::size_t satAxisCount = 0;
+    /// Number of vertices projected onto a separating axis.
+    std::size_t projectedVertexCount = 0;
+};
+
+/**
+ * @brief Statistics of the last simulation step, see Simulation::getStats().
+ */
+struct simulationStats {
+    /// Number of simulated bodies, including player bodies.
+    std::size_t bodyCount = 0;
+    /// Number of candidate pairs of the broadphase, i.e. body pairs that have been checked for a collision.
+    std::size_t testedPairCount = 0;
+    /// Number of body pairs that have been skipped because both bodies are static.
+    std::size_t skippedStaticPairCount = 0;
+    /// Number of detected contacts.
+    std::size_t contactCount = 0;
+    /// Number of detected contacts between bodies which don't touch yet (included in contactCount).
+    std::size_t speculativeContactCount = 0;
+    /// Number of colors the ContactSolver split the contacts into.
+    std::size_t colorCount = 0;
+    /// Number of contacts for which no impulse could be computed (see resolveResult::degenerate).
+    std::size_t degenerateContactCount = 0;
+    /// Number of contacts which received an impulse, i.e. contactCount without the degenerate and the separating contacts.
+    std::size_t resolvedContactCount = 0;
+    /// Number of collision impulses applied, one per resolved contact and resolved bullet impact (each affects both bodies).
+    std::size_t impulseCount = 0;
+    /// Number of bodies whose position and rotation have been updated, including bullets and player bodies.
+    std::size_t integratedBodyCount = 0;
+    /// Collision checks per shape pair and SAT work of the step.
+    narrowphaseCounters narrowphase;
+    /// Sum of degenerateContactCount over all steps so far.
+    std::size_t totalDegenerateContactCount = 0;
+    /// Number of impacts found by the continuous collision detection for bullets.
+    std::size_t bulletImpactCount = 0;
+    /// Number of heap allocations during the step. Only counted if COLLISION2D_TRACK_ALLOCATIONS is defined (see AllocationTracker).
+    std::size_t allocationCount = 0;
+    /// Memory used in the frame arena by the last step, in bytes.
+    std::size_t frameArenaUsedBytes = 0;
+    /// Largest memory use of any step in the frame arena so far, in bytes.
+    std::size_t frameArenaHighWaterMark = 0;
+    /// Memory the frame arena can hand out per step without allocating, in bytes.
+    std::size_t frameArenaCapacity = 0;
+};
@@ -0,0 +1,192 @@
+#include "SlowStepRecorder.hpp"
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+
+/**
+ * @brief The time budget of a step.
+ * @return The budget in seconds, 0 if no budget is set.
+ */
+float SlowStepRecorder::getBudget() const {
+    return m_budget;
+}
+
+/**
+ * @brief The number of reports written since the budget was set.
+ * @return The report count.
+ */
+std::size_t SlowStepRecorder::getReportCount() const {
+    return m_reportCount;
+}
+
+/**
+ * @brief The path of the last written report.
+ * @return The path, empty if no report has been written yet.
+ */
+const std::string & SlowStepRecorder::getLastReportPath() const {
+    return m_lastReportPath;
+}
+
+/**
+ * @brief Set the time budget of a step and start recording slow steps.
+ * @param i_budget Maximum time of a step in seconds. Put in zero to stop recording.
+ * @param i_pathPrefix Prepended to the frame number to get the path of a report. The directory must exist.
+ * @param i_maxReportCount Recording stops after this many reports.
+ */
+void SlowStepRecorder::setBudget(float i_budget, const std::string & i_pathPrefix, std::size_t i_maxReportCount) {
+    m_budget = i_budget;
+    m_pathPrefix = i_pathPrefix;
+    m_maxReportCount = i_maxReportCount;
+    m_reportCount = 0;
+}
+
+/**
+ * @brief Check if steps are recorded at all, i.e. if a snapshot has to be taken at the start of a step.
+ * @return true if a budget is set and the maximum number of reports hasn't been reached yet.
+ */
+bool SlowStepRecorder::isRecording() const {
+    return m_budget > 0.0f && m_reportCount < m_maxReportCount;
+}
+
+/**
+ * @brief Check if a step needs to be recorded.
+ * @param i_stepTime Time of the step in seconds.
+ * @return true if a budget is set, the step took longer and the maximum number of reports hasn't been reached yet.
+ */
+bool SlowStepRecorder::isOverBudget(float i_stepTime) const {
+    return isRecording() && i_stepTime > m_budget;
+}
+
+/**
+ * @brief Discard the snapshot of the previous step. Call it at the start of a step, followed by addToSnapshot() for every body.
+ */
+void SlowStepRecorder::startSnapshot() {
+    m_snapshot.clear();
+}
+
+/**
+ * @brief Copy the state of a body into the snapshot of the current step.
+ * @param i_body A body or BoundaryElement of the world.
+ */
+void SlowStepRecorder::addToSnapshot(const RigidBody & i_body) {
+    bodySnapshot snapshot;
+    snapshot.shape = &i_body.getShape();
+    snapshot.inverseMass = i_body.getInverseMass();
+    snapshot.position = i_body.getPosition();
+    snapshot.orientation = i_body.getOrientation();
+    snapshot.velocity = i_body.getVelocity();
+    snapshot.angularVelocity = i_body.getAngularVelocityRadians();
+    snapshot.restitution = i_body.getRestitutionCoefficient();
+    snapshot.friction = i_body.getFrictionCoefficient();
+    snapshot.isBullet = i_body.isBullet();
+    m_snapshot.push_back(snapshot);
+}
+
+/**
+ * @brief Write a report of the last step into a file, if it was over budget. Call it after Profiler::endFrame().
+ * @param i_stepTime Time of the step in seconds.
+ * @param i_dT The time step of the simulation in seconds.
+ * @param i_profiler Contains the time of every phase of the step.
+ * @param i_stats The counters of the step.
+ * @return true if a report has been written.
+ */
+bool SlowStepRecorder::record(float i_stepTime, float i_dT, const Profiler & i_profiler, const simulationStats & i_stats) {
+    if (!isOverBudget(i_stepTime)) {
+        return false;
+    }
+    // Count failed reports as well, so a missing directory doesn't cost a file operation every step
+    m_reportCount++;
+    std::string path = m_pathPrefix + std::to_string(i_profiler.getFrameCount()) + ".json";
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+    writeReport(file, i_stepTime, i_dT, i_profiler, i_stats);
+    if (!file) {
+        return false;
+    }
+    m_lastReportPath = path;
+    return true;
+}
+
+/**
+ * @brief Write the report of the last step as JSON, with the snapshot taken at its start.
+ * @param o_stream The stream to write to. Its precision is the same afterwards.
+ * @param i_stepTime Time of the step in seconds.
+ * @param i_dT The time step of the simulation in seconds.
+ * @param i_profiler Contains the time of every phase of the step.
+ * @param i_stats The counters of the step.
+ */
+void SlowStepRecorder::writeReport(std::ostream & o_stream, float i_stepTime, float i_dT, const Profiler & i_profiler,
+        const simulationStats & i_stats) const {
+    // Enough digits to read back the exact float. Restored at the end, so the caller's formatting isn't changed.
+    std::streamsize previousPrecision = o_stream.precision(std::numeric_limits<float>::max_digits10);
+    o_stream << "{\"frame\":" << i_profiler.getFrameCount() << ",\"stepTime\":" << i_stepTime << ",\"budget\":" << m_budget
+             << ",\"dT\":" << i_dT << ",\n";
+
+    // Times of the phases of this step in microseconds
+    o_stream << "\"phases\":{";
+    for (std::size_t phase = 0; phase < Profiler::PHASE_COUNT; phase++) {
+        profilePhase currentPhase = static_cast<profilePhase>(phase);
+        o_stream << (phase == 0 ? "" : ",") << "\"" << Profiler::getPhaseName(currentPhase)
+                 << "\":" << i_profiler.getStatistics(currentPhase).last;
+    }
+    o_stream << "},\n";
+
+    const narrowphaseCounters & narrowphase = i_stats.narrowphase;
+    o_stream << "\"stats\":{\"bodyCount\":" << i_stats.bodyCount << ",\"testedPairCount\":" << i_stats.testedPairCount
+             << ",\"skippedStaticPairCount\":" << i_stats.skippedStaticPairCount << ",\"contactCount\":" << i_stats.contactCount
+             << ",\"speculativeContactCount\":" << i_stats.speculativeContactCount << ",\"colorCount\":" << i_stats.colorCount
+             << ",\"degenerateContactCount\":" << i_stats.degenerateContactCount
+             << ",\"resolvedContactCount\":" << i_stats.resolvedContactCount << ",\"impulseCount\":" << i_stats.impulseCount
+             << ",\"integratedBodyCount\":" << i_stats.integratedBodyCount << ",\"bulletImpactCount\":" << i_stats.bulletImpactCount
+             << ",\"allocationCount\":" << i_stats.allocationCount << ",\"frameArenaUsedBytes\":" << i_stats.frameArenaUsedBytes
+             << ",\"polygonPolygonCount\":" << narrowphase.polygonPolygonCount
+             << ",\"polygonCircleCount\":" << narrowphase.polygonCircleCount << ",\"circleCircleCount\":" << narrowphase.circleCircleCount
+             << ",\"segmentPolygonCount\":" << narrowphase.segmentPolygonCount
+             << ",\"segmentCircleCount\":" << narrowphase.segmentCircleCount << ",\"satAxisCount\":" << narrowphase.satAxisCount
+             << ",\"projectedVertexCount\":" << narrowphase.projectedVertexCount << "},\n";
+
+    // Every shape only once, bodies refer to their shape by its index. Scenes usually share a few shapes between many bodies.
+    std::vector<const ShapeDefinition *> shapes;
+    std::unordered_map<const ShapeDefinition *, std::size_t> shapeIndices;
+    for (const bodySnapshot & body : m_snapshot) {
+        if (shapeIndices.emplace(body.shape, shapes.size()).second) {
+            shapes.push_back(body.shape);
+        }
+    }
+    o_stream << "\"shapes\":[";
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        const ShapeDefinition & shape = *shapes[i];
+        o_stream << (i == 0 ? "\n" : ",\n");
+        switch (shape.getType()) {
+        case shapeType::circle:
+            o_stream << "{\"type\":\"circle\",\"radius\":" << shape.getRadius() << "}";
+            break;
+        case shapeType::segment:
+            o_stream << "{\"type\":\"segment\",\"length\":" << 2.0f * shape.getBoundingRadius() << "}";
+            break;
+        default:
+            // Relative to the center of mass, so the shape can be recreated with ShapeDefinition::createPolygon()
+            o_stream << "{\"type\":\"polygon\",\"vertices\":[";
+            for (std::size_t vertex = 0; vertex < shape.getVertices().size; vertex++) {
+                o_stream << (vertex == 0 ? "" : ",") << "[" << shape.getVertices()[vertex].x << "," << shape.getVertices()[vertex].y << "]";
+            }
+            o_stream << "]}";
+            break;
+        }
+    }
+    o_stream << "],\n";
+
+    o_stream << "\"bodies\":[";
+    for (std::size_t i = 0; i < m_snapshot.size(); i++) {
+        const bodySnapshot & body = m_snapshot[i];
+        o_stream << (i == 0 ? "\n" : ",\n") << "{\"shape\":" << shapeIndices[body.shape] << ",\"inverseMass\":" << body.inverseMass
+                 << ",\"position\":[" << body.position.x << "," << body.position.y << "],\"orientation\":" << body.orientation
+                 << ",\"velocity\":[" << body.velocity.x << "," << body.velocity.y << "],\"angularVelocity\":" << body.angularVelocity
+                 << ",\"restitution\":" << body.restitution << ",\"friction\":" << body.friction
+                 << ",\"bullet\":" << (body.isBullet ? "true" : "false") << "}";
+    }
+    o_stream << "]}\n";
+    o_stream.precision(previousPrecision);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Profiler.hpp"
+#include "RigidBody.hpp"
+#include "ShapeDefinition.hpp"
+#include "SimulationStats.hpp"
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The state of a body or BoundaryElement at the start of a step, with everything needed to rebuild it.
+ */
+struct bodySnapshot {
+    /// Owned by the body, valid until the end of the step.
+    const ShapeDefinition * shape = nullptr;
+    float inverseMass = 0.0f;
+    sf::Vector2f position;
+    /// In radians.
+    float orientation = 0.0f;
+    sf::Vector2f velocity;
+    /// In radians per second.
+    float angularVelocity = 0.0f;
+    float restitution = 0.0f;
+    float friction = 0.0f;
+    bool isBullet = false;
+};
+
+/**
+ * @class SlowStepRecorder
+ * @brief Writes a report of every step that takes longer than a time budget, so hitches can be reproduced and profiled offline.
+ *
+ * A report is a JSON file with the step time, the time of every phase (see Profiler), all counters of simulationStats and a compact
+ * snapshot of the world: every shape once, and the state of every body and BoundaryElement referring to its shape. The snapshot is taken
+ * at the start of every step while a budget is set (see startSnapshot()), as the time of a step is only known at its end. The bodies are
+ * stored with full float precision, so the slow step can be reproduced exactly from the state it started with.
+ *
+ * Nothing is measured or written until a budget has been set. The number of reports is limited, so a scene which is always too slow
+ * doesn't fill the disk.
+ */
+class SlowStepRecorder {
+  public:
+    // Constructor
+    SlowStepRecorder() = default;
+
+    // Getters
+    float getBudget() const;
+    std::size_t getReportCount() const;
+    const std::string & getLastReportPath() const;
+
+    // Setters
+    void setBudget(float i_budget, const std::string & i_pathPrefix = DEFAULT_PATH_PREFIX,
+            std::size_t i_maxReportCount = DEFAULT_MAX_REPORT_COUNT);
+
+    // Public methods
+    bool isRecording() const;
+    bool isOverBudget(float i_stepTime) const;
+    void startSnapshot();
+    void addToSnapshot(const RigidBody & i_body);
+    bool record(float i_stepTime, float i_dT, const Profiler & i_profiler, const simulationStats & i_stats);
+    void writeReport(std::ostream & o_stream, float i_stepTime, float i_dT, const Profiler & i_profiler,
+            const simulationStats & i_stats) const;
+
+    /// Reports are written to the working directory by default, e.g. "slow_step_1234.json" for frame 1234.
+    static constexpr const char * DEFAULT_PATH_PREFIX = "slow_step_";
+    static constexpr std::size_t DEFAULT_MAX_REPORT_COUNT = 16;
+
+  private:
+    // Deleted copy constructor and assignment operator
+    SlowStepRecorder(const SlowStepRecorder &) = delete;
+    SlowStepRecorder & operator=(const SlowStepRecorder &) = delete;
+
+    // Member variables
+    /// In seconds, 0 if disabled.
+    float m_budget = 0.0f;
+    /// Prepended to the frame number to get the path of a report, may contain a directory.
+    std::string m_pathPrefix = DEFAULT_PATH_PREFIX;
+    std::size_t m_maxReportCount = DEFAULT_MAX_REPORT_COUNT;
+    std::size_t m_reportCount = 0;
+    std::string m_lastReportPath;
+    /// The bodies at the start of the current step. Keeps its capacity, so taking a snapshot doesn't allocate once the scene has settled.
+    std::vector<bodySnapshot> m_snapshot;
+};
@@ -0,0 +1,118 @@
+#include "TraceRecorder.hpp"
+#include <algorithm>
+#include <fstream>
+
+/**
+ * @brief Check if spans are being recorded.
+ * @return true between start() and stop().
+ */
+bool TraceRecorder::isRecording() const {
+    return m_isRecording.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief The maximum number of spans in the ring buffer.
+ * @return The capacity.
+ */
+std::size_t TraceRecorder::getCapacity() const {
+    return m_spans.size();
+}
+
+/**
+ * @brief The number of spans which are currently in the ring buffer.
+ * @return The span count.
+ */
+std::size_t TraceRecorder::getSpanCount() const {
+    return static_cast<std::size_t>(std::min<std::uint64_t>(m_nextSpan.load(), m_spans.size()));
+}
+
+/**
+ * @brief The number of spans which have been overwritten because the ring buffer was full.
+ * @return The number of lost spans.
+ */
+std::uint64_t TraceRecorder::getDroppedSpanCount() const {
+    return m_nextSpan.load() - getSpanCount();
+}
+
+/**
+ * @brief Discard all spans and start recording. Allocates the ring buffer, so don't call this in the middle of a step.
+ * @param i_capacity The maximum number of spans to keep.
+ */
+void TraceRecorder::start(std::size_t i_capacity) {
+    m_isRecording.store(false);
+    m_spans.assign(std::max<std::size_t>(i_capacity, 1), traceSpan());
+    m_nextSpan.store(0);
+    m_epoch = clock::now();
+    m_isRecording.store(true);
+}
+
+/**
+ * @brief Stop recording. The recorded spans are kept until the next start().
+ */
+void TraceRecorder::stop() {
+    m_isRecording.store(false);
+}
+
+/**
+ * @brief Add a span to the ring buffer. Does nothing if the recorder isn't recording.
+ * @param i_name Name of the span, must outlive the recorder (e.g. a string literal).
+ * @param i_threadIndex 0 for the simulation thread, the index of the worker thread otherwise.
+ * @param i_start Beginning of the span.
+ * @param i_end End of the span.
+ */
+void TraceRecorder::record(const char * i_name, std::uint32_t i_threadIndex, clock::time_point i_start, clock::time_point i_end) {
+    if (!isRecording()) {
+        return;
+    }
+    traceSpan & span = m_spans[m_nextSpan.fetch_add(1, std::memory_order_relaxed) % m_spans.size()];
+    span.name = i_name;
+    span.threadIndex = i_threadIndex;
+    span.start = std::chrono::duration_cast<std::chrono::nanoseconds>(i_start - m_epoch).count();
+    span.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(i_end - i_start).count();
+}
+
+/**
+ * @brief Write the recorded spans as Chrome trace event JSON, oldest span first.
+ * @param o_stream The stream to write to. Its formatting is the same afterwards.
+ */
+void TraceRecorder::writeChromeTrace(std::ostream & o_stream) const {
+    std::size_t spanCount = getSpanCount();
+    std::size_t firstSpan = static_cast<std::size_t>(m_nextSpan.load() - spanCount) % std::max<std::size_t>(m_spans.size(), 1);
+    std::uint32_t threadCount = 0;
+
+    o_stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    // Restored at the end, so the caller's formatting isn't changed
+    std::ios::fmtflags previousFlags = o_stream.flags();
+    std::streamsize previousPrecision = o_stream.precision(3);
+    o_stream.setf(std::ios::fixed);
+    for (std::size_t i = 0; i < spanCount; i++) {
+        const traceSpan & span = m_spans[(firstSpan + i) % m_spans.size()];
+        // Complete events ("X") with timestamps in microseconds
+        o_stream << "{\"name\":\"" << span.name << "\",\"cat\":\"Collision2D\",\"ph\":\"X\",\"pid\":1,\"tid\":" << span.threadIndex
+                 << ",\"ts\":" << span.start / 1000.0 << ",\"dur\":" << span.duration / 1000.0 << "},\n";
+        threadCount = std::max(threadCount, span.threadIndex + 1);
+    }
+    // Name the threads, so the viewer shows them in a sensible order
+    for (std::uint32_t thread = 0; thread < threadCount; thread++) {
+        std::string threadName = thread == 0 ? "Simulation" : "Worker " + std::to_string(thread);
+        o_stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread << ",\"args\":{\"name\":\"" << threadName
+                 << "\"}},\n";
+    }
+    o_stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Collision2D\"}}\n]}\n";
+    o_stream.flags(previousFlags);
+    o_stream.precision(previousPrecision);
+}
+
+/**
+ * @brief Write the recorded spans as Chrome trace event JSON into a file.
+ * @param i_path The path of the file. An existing file is overwritten.
+ * @return false if the file couldn't be written.
+ */
+bool TraceRecorder::writeChromeTrace(const std::string & i_path) const {
+    std::ofstream file(i_path);
+    if (!file) {
+        return false;
+    }
+    writeChromeTrace(file);
+    return static_cast<bool>(file);
+}
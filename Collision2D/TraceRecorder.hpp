@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A timed section of code on one thread, e.g. a phase of a frame or a job of a worker thread.
+ */
+struct traceSpan {
+    /// Must point to a string literal (or any other string that outlives the recorder).
+    const char * name = nullptr;
+    /// 0 for the thread running the Simulation, 1 and above for the threads of the WorkerPool.
+    std::uint32_t threadIndex = 0;
+    /// In nanoseconds since TraceRecorder::start().
+    std::int64_t start = 0;
+    /// In nanoseconds.
+    std::int64_t duration = 0;
+};
+
+/**
+ * @class TraceRecorder
+ * @brief Records spans of the simulation into a ring buffer and writes them in the Chrome trace event format.
+ *
+ * The written JSON file can be opened in chrome://tracing or https://ui.perfetto.dev to see the frames, the phases of every frame and the
+ * utilization of the worker threads on a timeline. Once the ring buffer is full, the oldest spans are overwritten, so a capture always
+ * holds the most recent spans.
+ *
+ * Spans can be recorded from any thread without locking. Only write the trace while no spans are being recorded, e.g. between two steps.
+ */
+class TraceRecorder {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    // Constructor
+    TraceRecorder() = default;
+
+    // Getters
+    bool isRecording() const;
+    std::size_t getCapacity() const;
+    std::size_t getSpanCount() const;
+    std::uint64_t getDroppedSpanCount() const;
+
+    // Public methods
+    void start(std::size_t i_capacity = DEFAULT_CAPACITY);
+    void stop();
+    void record(const char * i_name, std::uint32_t i_threadIndex, clock::time_point i_start, clock::time_point i_end);
+    void writeChromeTrace(std::ostream & o_stream) const;
+    bool writeChromeTrace(const std::string & i_path) const;
+
+    /// Enough for about ten seconds of a busy scene at 120 frames per second (16 MB).
+    static constexpr std::size_t DEFAULT_CAPACITY = 512 * 1024;
+
+  private:
+    // Deleted copy constructor and assignment operator
+    TraceRecorder(const TraceRecorder &) = delete;
+    TraceRecorder & operator=(const TraceRecorder &) = delete;
+
+    // Member variables
+    /// The ring buffer. Only resized by start().
+    std::vector<traceSpan> m_spans;
+    /// Total number of spans recorded since start(). The next span goes to m_nextSpan % capacity.
+    std::atomic<std::uint64_t> m_nextSpan{0};
+    std::atomic<bool> m_isRecording{false};
+    /// All span times are relative to this point, so they fit the trace viewer's microsecond timestamps.
+    clock::time_point m_epoch;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RigidBody.hpp"
+#include <limits>
 
 /**
  * @brief Stores data related to the separation between a VertexBasedBody and a single point.
@@ -25,25 +26,16 @@ struct pointSeparationData_type {
 class VertexBasedBody : public RigidBody {
   public:
     // Constructor
-    VertexBasedBody(float i_inverseMass, std::vector<sf::Vector2f> i_vertices);
+    VertexBasedBody(float i_inverseMass, std::shared_ptr<const ShapeDefinition> i_shape);
 
     // Destructor
     virtual ~VertexBasedBody();
 
     // Getters
-    std::vector<sf::Vector2f> getPoints();
-    virtual sf::Vector2f getNormal(int i_index) = 0;
-    virtual size_t getNormalCount() = 0;
-    sf::Vector2f getGlobalPoint(int i_index);
+    vertexSpan getPoints() const;
+    sf::Vector2f getNormal(int i_index) const;
+    size_t getNormalCount() const;
+    sf::Vector2f getGlobalPoint(int i_index) const;
     sf::Vector2f getGlobalNormal(int i_index);
     virtual pointSeparationData_type calculateMinPointSeparation(sf::Vector2f i_point) = 0;
-
-  protected:
-    // Utility methods
-    float calculateSignedArea();
-
-    // Override virtual methods
-    void calculateAndSetArea() override;
-    float calculateInverseMomentOfInertia() override;
-    sf::Vector2f calculateCenterOfMass() override;
 };
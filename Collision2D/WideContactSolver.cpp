@@ -0,0 +1,381 @@
+#include "WideContactSolver.hpp"
+#include "sfml_utility.hpp"
+
+// SIMD kernels are only available on x86. Everything else uses the scalar kernel.
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define WIDE_SOLVER_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+// MSVC allows AVX intrinsics in any function
+#define WIDE_SOLVER_TARGET_AVX2
+#else
+// GCC and Clang need to be told that this function may use AVX2, the rest of the program is compiled without it
+#define WIDE_SOLVER_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define WIDE_SOLVER_X86 0
+#endif
+
+namespace {
+const int SCALAR_LANES = 4;
+const int SSE_LANES = 4;
+const int AVX2_LANES = 8;
+
+/**
+ * @brief Reference kernel, evaluates the same formulas as CollisionEvent::resolve() one lane after another.
+ * @param io_lanes The contacts. Velocities are updated in place.
+ * @return Bit masks of the lanes which received an impulse and of the lanes whose bodies both have infinite inertia.
+ */
+laneMasks computeImpulsesScalar(contactLanes & io_lanes) {
+    laneMasks masks;
+    for (int i = 0; i < SCALAR_LANES; i++) {
+        float nx = io_lanes.normalX[i];
+        float ny = io_lanes.normalY[i];
+        float r0x = io_lanes.relativePosition0X[i];
+        float r0y = io_lanes.relativePosition0Y[i];
+        float r1x = io_lanes.relativePosition1X[i];
+        float r1y = io_lanes.relativePosition1Y[i];
+        float angVel0 = io_lanes.angularVelocity0[i];
+        float angVel1 = io_lanes.angularVelocity1[i];
+        // Local velocity in the contact point (translational and rotational part), projected onto the normal
+        float closingVelX = (io_lanes.velocity0X[i] - angVel0 * r0y) - (io_lanes.velocity1X[i] - angVel1 * r1y);
+        float closingVelY = (io_lanes.velocity0Y[i] + angVel0 * r0x) - (io_lanes.velocity1Y[i] + angVel1 * r1x);
+        float contactSpeed = closingVelX * nx + closingVelY * ny;
+        // Velocity change per unit impulse
+        float torqueArm0 = r0x * ny - r0y * nx;
+        float torqueArm1 = r1x * ny - r1y * nx;
+        float deltaVelPerUnitImpulse = io_lanes.inverseMass0[i] + io_lanes.inverseMass1[i] +
+                io_lanes.inverseMomentOfInertia0[i] * torqueArm0 * torqueArm0 +
+                io_lanes.inverseMomentOfInertia1[i] * torqueArm1 * torqueArm1;
+
+        float allowedContactSpeed = io_lanes.allowedContactSpeed[i];
+        float impulse = 0.0f;
+        if (contactSpeed > allowedContactSpeed && deltaVelPerUnitImpulse > 0) {
+            impulse = (allowedContactSpeed - contactSpeed * (1 + io_lanes.restitutionCoefficient[i])) / deltaVelPerUnitImpulse;
+            masks.resolvedLanes |= 1 << i;
+        } else if (contactSpeed > allowedContactSpeed) {
+            masks.degenerateLanes |= 1 << i;
+        }
+        io_lanes.impulse[i] = impulse;
+        io_lanes.velocity0X[i] += io_lanes.inverseMass0[i] * impulse * nx;
+        io_lanes.velocity0Y[i] += io_lanes.inverseMass0[i] * impulse * ny;
+        io_lanes.angularVelocity0[i] += io_lanes.inverseMomentOfInertia0[i] * torqueArm0 * impulse;
+        io_lanes.velocity1X[i] -= io_lanes.inverseMass1[i] * impulse * nx;
+        io_lanes.velocity1Y[i] -= io_lanes.inverseMass1[i] * impulse * ny;
+        io_lanes.angularVelocity1[i] -= io_lanes.inverseMomentOfInertia1[i] * torqueArm1 * impulse;
+    }
+    return masks;
+}
+
+#if WIDE_SOLVER_X86
+/**
+ * @brief SSE2 version of computeImpulsesScalar(), handles 4 lanes at once.
+ */
+laneMasks computeImpulsesSse(contactLanes & io_lanes) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    __m128 nx = _mm_load_ps(io_lanes.normalX);
+    __m128 ny = _mm_load_ps(io_lanes.normalY);
+    __m128 r0x = _mm_load_ps(io_lanes.relativePosition0X);
+    __m128 r0y = _mm_load_ps(io_lanes.relativePosition0Y);
+    __m128 r1x = _mm_load_ps(io_lanes.relativePosition1X);
+    __m128 r1y = _mm_load_ps(io_lanes.relativePosition1Y);
+    __m128 v0x = _mm_load_ps(io_lanes.velocity0X);
+    __m128 v0y = _mm_load_ps(io_lanes.velocity0Y);
+    __m128 v1x = _mm_load_ps(io_lanes.velocity1X);
+    __m128 v1y = _mm_load_ps(io_lanes.velocity1Y);
+    __m128 w0 = _mm_load_ps(io_lanes.angularVelocity0);
+    __m128 w1 = _mm_load_ps(io_lanes.angularVelocity1);
+    __m128 invMass0 = _mm_load_ps(io_lanes.inverseMass0);
+    __m128 invMass1 = _mm_load_ps(io_lanes.inverseMass1);
+    __m128 invMoi0 = _mm_load_ps(io_lanes.inverseMomentOfInertia0);
+    __m128 invMoi1 = _mm_load_ps(io_lanes.inverseMomentOfInertia1);
+    __m128 restitution = _mm_load_ps(io_lanes.restitutionCoefficient);
+    __m128 allowedContactSpeed = _mm_load_ps(io_lanes.allowedContactSpeed);
+
+    // Local velocity in the contact point, projected onto the normal
+    __m128 closingVelX = _mm_sub_ps(_mm_sub_ps(v0x, _mm_mul_ps(w0, r0y)), _mm_sub_ps(v1x, _mm_mul_ps(w1, r1y)));
+    __m128 closingVelY = _mm_sub_ps(_mm_add_ps(v0y, _mm_mul_ps(w0, r0x)), _mm_add_ps(v1y, _mm_mul_ps(w1, r1x)));
+    __m128 contactSpeed = _mm_add_ps(_mm_mul_ps(closingVelX, nx), _mm_mul_ps(closingVelY, ny));
+    // Velocity change per unit impulse
+    __m128 torqueArm0 = _mm_sub_ps(_mm_mul_ps(r0x, ny), _mm_mul_ps(r0y, nx));
+    __m128 torqueArm1 = _mm_sub_ps(_mm_mul_ps(r1x, ny), _mm_mul_ps(r1y, nx));
+    __m128 deltaVelPerUnitImpulse = _mm_add_ps(_mm_add_ps(invMass0, invMass1),
+            _mm_add_ps(_mm_mul_ps(invMoi0, _mm_mul_ps(torqueArm0, torqueArm0)), _mm_mul_ps(invMoi1, _mm_mul_ps(torqueArm1, torqueArm1))));
+
+    // Only approaching contacts with finite inertia receive an impulse
+    __m128 approaching = _mm_cmpgt_ps(contactSpeed, allowedContactSpeed);
+    __m128 solvable = _mm_cmpgt_ps(deltaVelPerUnitImpulse, zero);
+    __m128 impulse = _mm_sub_ps(allowedContactSpeed, _mm_mul_ps(contactSpeed, _mm_add_ps(one, restitution)));
+    impulse = _mm_and_ps(_mm_div_ps(impulse, deltaVelPerUnitImpulse), _mm_and_ps(approaching, solvable));
+    laneMasks masks;
+    masks.resolvedLanes = _mm_movemask_ps(_mm_and_ps(approaching, solvable));
+    masks.degenerateLanes = _mm_movemask_ps(_mm_andnot_ps(solvable, approaching));
+
+    // Apply the impulse to body 0 and the opposite impulse to body 1
+    __m128 impulseX = _mm_mul_ps(impulse, nx);
+    __m128 impulseY = _mm_mul_ps(impulse, ny);
+    _mm_store_ps(io_lanes.impulse, impulse);
+    _mm_store_ps(io_lanes.velocity0X, _mm_add_ps(v0x, _mm_mul_ps(invMass0, impulseX)));
+    _mm_store_ps(io_lanes.velocity0Y, _mm_add_ps(v0y, _mm_mul_ps(invMass0, impulseY)));
+    _mm_store_ps(io_lanes.angularVelocity0, _mm_add_ps(w0, _mm_mul_ps(_mm_mul_ps(invMoi0, torqueArm0), impulse)));
+    _mm_store_ps(io_lanes.velocity1X, _mm_sub_ps(v1x, _mm_mul_ps(invMass1, impulseX)));
+    _mm_store_ps(io_lanes.velocity1Y, _mm_sub_ps(v1y, _mm_mul_ps(invMass1, impulseY)));
+    _mm_store_ps(io_lanes.angularVelocity1, _mm_sub_ps(w1, _mm_mul_ps(_mm_mul_ps(invMoi1, torqueArm1), impulse)));
+    return masks;
+}
+
+/**
+ * @brief AVX2 version of computeImpulsesScalar(), handles 8 lanes at once.
+ */
+WIDE_SOLVER_TARGET_AVX2 laneMasks computeImpulsesAvx2(contactLanes & io_lanes) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    __m256 nx = _mm256_load_ps(io_lanes.normalX);
+    __m256 ny = _mm256_load_ps(io_lanes.normalY);
+    __m256 r0x = _mm256_load_ps(io_lanes.relativePosition0X);
+    __m256 r0y = _mm256_load_ps(io_lanes.relativePosition0Y);
+    __m256 r1x = _mm256_load_ps(io_lanes.relativePosition1X);
+    __m256 r1y = _mm256_load_ps(io_lanes.relativePosition1Y);
+    __m256 v0x = _mm256_load_ps(io_lanes.velocity0X);
+    __m256 v0y = _mm256_load_ps(io_lanes.velocity0Y);
+    __m256 v1x = _mm256_load_ps(io_lanes.velocity1X);
+    __m256 v1y = _mm256_load_ps(io_lanes.velocity1Y);
+    __m256 w0 = _mm256_load_ps(io_lanes.angularVelocity0);
+    __m256 w1 = _mm256_load_ps(io_lanes.angularVelocity1);
+    __m256 invMass0 = _mm256_load_ps(io_lanes.inverseMass0);
+    __m256 invMass1 = _mm256_load_ps(io_lanes.inverseMass1);
+    __m256 invMoi0 = _mm256_load_ps(io_lanes.inverseMomentOfInertia0);
+    __m256 invMoi1 = _mm256_load_ps(io_lanes.inverseMomentOfInertia1);
+    __m256 restitution = _mm256_load_ps(io_lanes.restitutionCoefficient);
+    __m256 allowedContactSpeed = _mm256_load_ps(io_lanes.allowedContactSpeed);
+
+    // Local velocity in the contact point, projected onto the normal
+    __m256 closingVelX = _mm256_sub_ps(_mm256_sub_ps(v0x, _mm256_mul_ps(w0, r0y)), _mm256_sub_ps(v1x, _mm256_mul_ps(w1, r1y)));
+    __m256 closingVelY = _mm256_sub_ps(_mm256_add_ps(v0y, _mm256_mul_ps(w0, r0x)), _mm256_add_ps(v1y, _mm256_mul_ps(w1, r1x)));
+    __m256 contactSpeed = _mm256_add_ps(_mm256_mul_ps(closingVelX, nx), _mm256_mul_ps(closingVelY, ny));
+    // Velocity change per unit impulse
+    __m256 torqueArm0 = _mm256_sub_ps(_mm256_mul_ps(r0x, ny), _mm256_mul_ps(r0y, nx));
+    __m256 torqueArm1 = _mm256_sub_ps(_mm256_mul_ps(r1x, ny), _mm256_mul_ps(r1y, nx));
+    __m256 deltaVelPerUnitImpulse = _mm256_add_ps(_mm256_add_ps(invMass0, invMass1),
+            _mm256_add_ps(_mm256_mul_ps(invMoi0, _mm256_mul_ps(torqueArm0, torqueArm0)),
+                    _mm256_mul_ps(invMoi1, _mm256_mul_ps(torqueArm1, torqueArm1))));
+
+    // Only approaching contacts with finite inertia receive an impulse
+    __m256 approaching = _mm256_cmp_ps(contactSpeed, allowedContactSpeed, _CMP_GT_OQ);
+    __m256 solvable = _mm256_cmp_ps(deltaVelPerUnitImpulse, zero, _CMP_GT_OQ);
+    __m256 impulse = _mm256_sub_ps(allowedContactSpeed, _mm256_mul_ps(contactSpeed, _mm256_add_ps(one, restitution)));
+    impulse = _mm256_and_ps(_mm256_div_ps(impulse, deltaVelPerUnitImpulse), _mm256_and_ps(approaching, solvable));
+    laneMasks masks;
+    masks.resolvedLanes = _mm256_movemask_ps(_mm256_and_ps(approaching, solvable));
+    masks.degenerateLanes = _mm256_movemask_ps(_mm256_andnot_ps(solvable, approaching));
+
+    // Apply the impulse to body 0 and the opposite impulse to body 1
+    __m256 impulseX = _mm256_mul_ps(impulse, nx);
+    __m256 impulseY = _mm256_mul_ps(impulse, ny);
+    _mm256_store_ps(io_lanes.impulse, impulse);
+    _mm256_store_ps(io_lanes.velocity0X, _mm256_add_ps(v0x, _mm256_mul_ps(invMass0, impulseX)));
+    _mm256_store_ps(io_lanes.velocity0Y, _mm256_add_ps(v0y, _mm256_mul_ps(invMass0, impulseY)));
+    _mm256_store_ps(io_lanes.angularVelocity0,
+            _mm256_add_ps(w0, _mm256_mul_ps(_mm256_mul_ps(invMoi0, torqueArm0), impulse)));
+    _mm256_store_ps(io_lanes.velocity1X, _mm256_sub_ps(v1x, _mm256_mul_ps(invMass1, impulseX)));
+    _mm256_store_ps(io_lanes.velocity1Y, _mm256_sub_ps(v1y, _mm256_mul_ps(invMass1, impulseY)));
+    _mm256_store_ps(io_lanes.angularVelocity1,
+            _mm256_sub_ps(w1, _mm256_mul_ps(_mm256_mul_ps(invMoi1, torqueArm1), impulse)));
+    return masks;
+}
+#endif
+
+/**
+ * @brief Write the new velocities of a lane back to one of the bodies.
+ * @param io_body The body.
+ * @param i_velocity The new velocity.
+ * @param i_angularVelocity The new angular velocity in radians per second.
+ */
+void writeBackVelocity(RigidBody * io_body, sf::Vector2f i_velocity, float i_angularVelocity) {
+    // Bodies with infinite inertia don't change and must not be written to, other threads might be reading them
+    if (io_body->isStatic()) {
+        return;
+    }
+    io_body->setVelocity(i_velocity);
+    io_body->setAngularVelocityRadians(i_angularVelocity);
+}
+} // namespace
+
+/**
+ * @brief Constructor.
+ * @param i_simdLevel The instruction set to use. Falls back to the best supported one if the CPU doesn't support it.
+ */
+WideContactSolver::WideContactSolver(simdLevel i_simdLevel) {
+    simdLevel supportedLevel = detectSimdLevel();
+    if (static_cast<int>(i_simdLevel) > static_cast<int>(supportedLevel)) {
+        i_simdLevel = supportedLevel;
+    }
+    m_simdLevel = i_simdLevel;
+    switch (m_simdLevel) {
+#if WIDE_SOLVER_X86
+    case simdLevel::avx2:
+        m_kernel = &computeImpulsesAvx2;
+        m_laneCount = AVX2_LANES;
+        break;
+    case simdLevel::sse:
+        m_kernel = &computeImpulsesSse;
+        m_laneCount = SSE_LANES;
+        break;
+#endif
+    default:
+        m_simdLevel = simdLevel::scalar;
+        m_kernel = &computeImpulsesScalar;
+        m_laneCount = SCALAR_LANES;
+        break;
+    }
+}
+
+// Destructor.
+WideContactSolver::~WideContactSolver() {}
+
+simdLevel WideContactSolver::getSimdLevel() const {
+    return m_simdLevel;
+}
+
+/**
+ * @brief The number of contacts resolved at once by solveBatch().
+ * @return The lane count.
+ */
+int WideContactSolver::getLaneCount() const {
+    return m_laneCount;
+}
+
+/**
+ * @brief Resolve any number of contacts, split into batches of getLaneCount() contacts.
+ * @param i_contacts Pointers to the contacts. No two of them may share a movable body.
+ * @param i_count The number of contacts.
+ * @return The number of resolved and degenerate contacts (see resolveResult).
+ */
+contactCounts WideContactSolver::solve(CollisionEvent * const * i_contacts, std::size_t i_count) const {
+    contactCounts counts;
+    for (std::size_t i = 0; i < i_count; i += m_laneCount) {
+        std::size_t remaining = i_count - i;
+        contactCounts batchCounts =
+                solveBatch(i_contacts + i, remaining < static_cast<std::size_t>(m_laneCount) ? static_cast<int>(remaining) : m_laneCount);
+        counts.resolvedCount += batchCounts.resolvedCount;
+        counts.degenerateCount += batchCounts.degenerateCount;
+    }
+    return counts;
+}
+
+/**
+ * @brief Resolve up to getLaneCount() contacts at once: gather their data into lanes, run the SIMD kernel and write the new velocities
+ * back to the bodies.
+ * @param i_contacts Pointers to the contacts. No two of them may share a movable body.
+ * @param i_count The number of contacts, at most getLaneCount().
+ * @return The number of resolved and degenerate contacts (see resolveResult). The bodies of contacts which haven't been resolved are left
+ * unchanged.
+ */
+contactCounts WideContactSolver::solveBatch(CollisionEvent * const * i_contacts, int i_count) const {
+    contactLanes lanes = {}; // Unused lanes stay zero, which results in a zero impulse
+    std::array<RigidBody *, 2> bodies[contactLanes::MAX_LANES];
+
+    // Gather
+    for (int i = 0; i < i_count; i++) {
+        bodies[i] = i_contacts[i]->getCollisionPartners();
+        const collisionGeometry & geometry = i_contacts[i]->getCollisionGeometry();
+        RigidBody & body0 = *bodies[i][0];
+        RigidBody & body1 = *bodies[i][1];
+        sf::Vector2f relativePosition0 = sfu::subtractVectors(geometry.location, body0.getPosition());
+        sf::Vector2f relativePosition1 = sfu::subtractVectors(geometry.location, body1.getPosition());
+        sf::Vector2f velocity0 = body0.getVelocity();
+        sf::Vector2f velocity1 = body1.getVelocity();
+
+        lanes.normalX[i] = geometry.normals[0].x;
+        lanes.normalY[i] = geometry.normals[0].y;
+        lanes.relativePosition0X[i] = relativePosition0.x;
+        lanes.relativePosition0Y[i] = relativePosition0.y;
+        lanes.relativePosition1X[i] = relativePosition1.x;
+        lanes.relativePosition1Y[i] = relativePosition1.y;
+        lanes.velocity0X[i] = velocity0.x;
+        lanes.velocity0Y[i] = velocity0.y;
+        lanes.velocity1X[i] = velocity1.x;
+        lanes.velocity1Y[i] = velocity1.y;
+        lanes.angularVelocity0[i] = body0.getAngularVelocityRadians();
+        lanes.angularVelocity1[i] = body1.getAngularVelocityRadians();
+        lanes.inverseMass0[i] = body0.getInverseMass();
+        lanes.inverseMass1[i] = body1.getInverseMass();
+        lanes.inverseMomentOfInertia0[i] = body0.getInverseMomentOfInertia();
+        lanes.inverseMomentOfInertia1[i] = body1.getInverseMomentOfInertia();
+        // Speculative contacts don't bounce, see CollisionEvent::resolve()
+        if (!i_contacts[i]->isSpeculative()) {
+            lanes.restitutionCoefficient[i] = body0.getRestitutionCoefficient() * body1.getRestitutionCoefficient();
+        }
+        lanes.allowedContactSpeed[i] = i_contacts[i]->getAllowedContactSpeed();
+    }
+
+    laneMasks masks = m_kernel(lanes);
+
+    // Scatter
+    contactCounts counts;
+    for (int i = 0; i < i_count; i++) {
+        if ((masks.degenerateLanes & (1 << i)) != 0) {
+            counts.degenerateCount++;
+        } else if ((masks.resolvedLanes & (1 << i)) != 0) {
+            counts.resolvedCount++;
+            writeBackVelocity(bodies[i][0], sf::Vector2f(lanes.velocity0X[i], lanes.velocity0Y[i]), lanes.angularVelocity0[i]);
+            writeBackVelocity(bodies[i][1], sf::Vector2f(lanes.velocity1X[i], lanes.velocity1Y[i]), lanes.angularVelocity1[i]);
+        }
+    }
+    return counts;
+}
+
+/**
+ * @brief Determine the best instruction set supported by the CPU and the operating system.
+ * @return The SIMD level.
+ */
+simdLevel WideContactSolver::detectSimdLevel() {
+#if WIDE_SOLVER_X86
+#if defined(_MSC_VER)
+    int cpuInfo[4];
+    __cpuid(cpuInfo, 0);
+    int highestLeaf = cpuInfo[0];
+    __cpuid(cpuInfo, 1);
+    bool osUsesXsave = (cpuInfo[2] & (1 << 27)) != 0;
+    bool cpuHasAvx = (cpuInfo[2] & (1 << 28)) != 0;
+    if (highestLeaf >= 7 && osUsesXsave && cpuHasAvx) {
+        // The operating system also has to save the upper halves of the AVX registers
+        bool osSavesAvxState = (_xgetbv(0) & 0x6) == 0x6;
+        __cpuidex(cpuInfo, 7, 0);
+        bool cpuHasAvx2 = (cpuInfo[1] & (1 << 5)) != 0;
+        if (osSavesAvxState && cpuHasAvx2) {
+            return simdLevel::avx2;
+        }
+    }
+    return simdLevel::sse;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return simdLevel::avx2;
+    }
+    return simdLevel::sse;
+#endif
+#else
+    return simdLevel::scalar;
+#endif
+}
+
+/**
+ * @brief Readable name of a SIMD level, e.g. for benchmark output.
+ * @param i_simdLevel The SIMD level.
+ * @return The name.
+ */
+const char * WideContactSolver::getSimdLevelName(simdLevel i_simdLevel) {
+    switch (i_simdLevel) {
+    case simdLevel::avx2:
+        return "AVX2";
+    case simdLevel::sse:
+        return "SSE2";
+    default:
+        return "scalar";
+    }
+}
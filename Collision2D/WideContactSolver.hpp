@@ -0,0 +1,103 @@
+#pragma once
+
+#include "CollisionEvent.hpp"
+
+/**
+ * @brief The instruction set used for resolving batches of contacts.
+ */
+enum class simdLevel {
+    scalar, ///< Plain C++, processes 4 contacts per batch in a loop.
+    sse,    ///< SSE2, processes 4 contacts at once.
+    avx2    ///< AVX2, processes 8 contacts at once.
+};
+
+/**
+ * @brief Structure of arrays holding the data needed to resolve up to MAX_LANES contacts at once. Every lane holds one contact.
+ *
+ * Body 0 and body 1 refer to the first and second collision partner. The normal is normals[0] of the collision geometry, relative positions
+ * are given in global coordinates relative to the body's center of mass.
+ */
+struct contactLanes {
+    static constexpr int MAX_LANES = 8;
+
+    alignas(32) float normalX[MAX_LANES];
+    alignas(32) float normalY[MAX_LANES];
+    alignas(32) float relativePosition0X[MAX_LANES];
+    alignas(32) float relativePosition0Y[MAX_LANES];
+    alignas(32) float relativePosition1X[MAX_LANES];
+    alignas(32) float relativePosition1Y[MAX_LANES];
+    alignas(32) float velocity0X[MAX_LANES];
+    alignas(32) float velocity0Y[MAX_LANES];
+    alignas(32) float velocity1X[MAX_LANES];
+    alignas(32) float velocity1Y[MAX_LANES];
+    /// In radians per second, like RigidBody::getAngularVelocityRadians().
+    alignas(32) float angularVelocity0[MAX_LANES];
+    alignas(32) float angularVelocity1[MAX_LANES];
+    alignas(32) float inverseMass0[MAX_LANES];
+    alignas(32) float inverseMass1[MAX_LANES];
+    alignas(32) float inverseMomentOfInertia0[MAX_LANES];
+    alignas(32) float inverseMomentOfInertia1[MAX_LANES];
+    alignas(32) float restitutionCoefficient[MAX_LANES];
+    /// Contact speed which doesn't need to be resolved, see CollisionEvent::getAllowedContactSpeed().
+    alignas(32) float allowedContactSpeed[MAX_LANES];
+    /// Output: the impulse along the normal applied to body 0 (body 1 receives the opposite impulse). Zero if the bodies are separating.
+    alignas(32) float impulse[MAX_LANES];
+};
+
+/**
+ * @brief Outcome of a batch kernel, one bit per lane.
+ */
+struct laneMasks {
+    /// Lanes which received an impulse (resolveResult::resolved).
+    int resolvedLanes = 0;
+    /// Lanes which approach, but both bodies have infinite inertia in the contact point (resolveResult::degenerate).
+    int degenerateLanes = 0;
+};
+
+/**
+ * @brief Number of contacts with each resolveResult, except resolveResult::separating.
+ */
+struct contactCounts {
+    std::size_t resolvedCount = 0;
+    std::size_t degenerateCount = 0;
+};
+
+/**
+ * @class WideContactSolver
+ * @brief Resolves contacts in batches, evaluating contact speed, velocity change per unit impulse and impulse application for several
+ * contacts at once with SIMD instructions.
+ *
+ * The instruction set is chosen at runtime depending on the CPU. The results match CollisionEvent::resolve() up to floating point
+ * rounding.
+ *
+ * @attention The contacts of one batch must not share any movable body, as all velocities of a batch are read before any of them is
+ * written. The colors of the ContactSolver guarantee this.
+ */
+class WideContactSolver {
+  public:
+    // Constructor
+    explicit WideContactSolver(simdLevel i_simdLevel = detectSimdLevel());
+
+    // Destructor
+    ~WideContactSolver();
+
+    // Getters
+    simdLevel getSimdLevel() const;
+    int getLaneCount() const;
+
+    // Public methods
+    contactCounts solve(CollisionEvent * const * i_contacts, std::size_t i_count) const;
+    contactCounts solveBatch(CollisionEvent * const * i_contacts, int i_count) const;
+    static simdLevel detectSimdLevel();
+    static const char * getSimdLevelName(simdLevel i_simdLevel);
+
+  private:
+    /// Computes the impulses for all lanes and updates the velocities in place. Returns which lanes have been resolved.
+    using batchKernel = laneMasks (*)(contactLanes & io_lanes);
+
+    // Member variables
+    simdLevel m_simdLevel;
+    batchKernel m_kernel;
+    /// Number of contacts processed per batch.
+    int m_laneCount;
+};
@@ -0,0 +1,129 @@
+#include "WorkerPool.hpp"
+#include <algorithm>
+
+/**
+ * @brief Constructor. Starts the worker threads.
+ * @param i_workerThreadCount The number of threads to start in addition to the calling thread. By default, one thread per hardware thread
+ * is used in total.
+ */
+WorkerPool::WorkerPool(unsigned int i_workerThreadCount) {
+    if (i_workerThreadCount == DEFAULT_WORKER_THREAD_COUNT) {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        // The calling thread also does work, so one thread less is needed
+        i_workerThreadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+    m_threads.reserve(i_workerThreadCount);
+    for (unsigned int i = 0; i < i_workerThreadCount; i++) {
+        m_threads.emplace_back(&WorkerPool::workerLoop, this, i + 1);
+    }
+}
+
+// Destructor. Wakes up and joins all worker threads.
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+    }
+    m_wakeCondition.notify_all();
+    for (std::thread & thread : m_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    m_threads.clear();
+}
+
+/**
+ * @brief The number of threads working on a job, including the calling thread.
+ * @return The thread count.
+ */
+unsigned int WorkerPool::getThreadCount() const {
+    return static_cast<unsigned int>(m_threads.size()) + 1;
+}
+
+/**
+ * @brief Record the time every thread spends on every job in a TraceRecorder, to see how well the threads are utilized.
+ * @param i_traceRecorder The recorder, or nullptr to stop recording. Spans are only recorded while the recorder is recording.
+ */
+void WorkerPool::setTraceRecorder(TraceRecorder * i_traceRecorder) {
+    m_traceRecorder = i_traceRecorder;
+}
+
+/**
+ * @brief Hand out a job to the workers, take part in it and wait until it is finished.
+ * @param i_count The number of indices to process.
+ * @param i_task The type-erased function processing a range of indices.
+ * @param i_context Passed to i_task unchanged.
+ */
+void WorkerPool::run(std::size_t i_count, taskFunction i_task, void * i_context) {
+    if (i_count == 0) {
+        return;
+    }
+    if (m_threads.empty()) {
+        // Nothing to distribute
+        i_task(i_context, 0, i_count);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = i_task;
+        m_context = i_context;
+        m_count = i_count;
+        // A few chunks per thread keep the threads busy if some indices take longer than others
+        m_chunkSize = std::max<std::size_t>(1, i_count / (getThreadCount() * 4));
+        m_nextIndex.store(0);
+        m_activeWorkers = static_cast<unsigned int>(m_threads.size());
+        m_generation++;
+    }
+    m_wakeCondition.notify_all();
+
+    processChunks(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [this] { return m_activeWorkers == 0; });
+}
+
+/**
+ * @brief Grab chunks of the current range until all of them have been handed out.
+ * @param i_threadIndex 0 for the calling thread, 1 and above for the worker threads.
+ */
+void WorkerPool::processChunks(std::uint32_t i_threadIndex) {
+    bool isTracing = m_traceRecorder != nullptr && m_traceRecorder->isRecording();
+    TraceRecorder::clock::time_point start = isTracing ? TraceRecorder::clock::now() : TraceRecorder::clock::time_point();
+    while (true) {
+        std::size_t begin = m_nextIndex.fetch_add(m_chunkSize);
+        if (begin >= m_count) {
+            break;
+        }
+        std::size_t end = std::min(begin + m_chunkSize, m_count);
+        m_task(m_context, begin, end);
+    }
+    if (isTracing) {
+        m_traceRecorder->record("job", i_threadIndex, start, TraceRecorder::clock::now());
+    }
+}
+
+/**
+ * @brief Main function of every worker thread. Sleeps until a new job arrives, helps processing it and reports back.
+ * @param i_threadIndex Index of the worker thread, starting at 1.
+ */
+void WorkerPool::workerLoop(std::uint32_t i_threadIndex) {
+    unsigned long long lastGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCondition.wait(lock, [this, lastGeneration] { return m_shutdown || m_generation != lastGeneration; });
+            if (m_shutdown) {
+                return;
+            }
+            lastGeneration = m_generation;
+        }
+
+        processChunks(i_threadIndex);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_activeWorkers == 0) {
+            m_doneCondition.notify_one();
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "TraceRecorder.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WorkerPool
+ * @brief A small pool of persistent worker threads for splitting an index range across all CPU cores.
+ *
+ * The threads are created once and sleep between jobs, so handing out work every frame does not create or destroy any threads. The
+ * calling thread always takes part in the work, so a pool with zero worker threads simply runs everything serially.
+ */
+class WorkerPool {
+  public:
+    // Constructor
+    explicit WorkerPool(unsigned int i_workerThreadCount = DEFAULT_WORKER_THREAD_COUNT);
+
+    // Destructor
+    ~WorkerPool();
+
+    // Getters
+    unsigned int getThreadCount() const;
+
+    // Setters
+    void setTraceRecorder(TraceRecorder * i_traceRecorder);
+
+    // Public methods
+    template <typename Function> void parallelFor(std::size_t i_count, Function & i_function);
+
+    /// Use one thread per hardware thread (the calling thread counts as one of them).
+    static constexpr unsigned int DEFAULT_WORKER_THREAD_COUNT = static_cast<unsigned int>(-1);
+
+  private:
+    /// Type-erased job: processes the indices [i_begin, i_end) of the current range.
+    using taskFunction = void (*)(void * i_context, std::size_t i_begin, std::size_t i_end);
+
+    // Deleted copy constructor and assignment operator
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool & operator=(const WorkerPool &) = delete;
+
+    // Private methods
+    void run(std::size_t i_count, taskFunction i_task, void * i_context);
+    void processChunks(std::uint32_t i_threadIndex);
+    void workerLoop(std::uint32_t i_threadIndex);
+
+    // Member variables
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_doneCondition;
+    /// The job that is currently being processed. Only written while all workers are idle.
+    taskFunction m_task = nullptr;
+    void * m_context = nullptr;
+    std::size_t m_count = 0;
+    std::size_t m_chunkSize = 1;
+    /// The next index of the current range that has not been handed out yet.
+    std::atomic<std::size_t> m_nextIndex{0};
+    /// Number of worker threads that have not finished the current job yet.
+    unsigned int m_activeWorkers = 0;
+    /// Incremented for every job, so sleeping workers can tell a new job from a spurious wakeup.
+    unsigned long long m_generation = 0;
+    bool m_shutdown = false;
+    /// Receives one span per thread and job, may be nullptr.
+    TraceRecorder * m_traceRecorder = nullptr;
+};
+
+/**
+ * @brief Call i_function(i) for every i in [0, i_count), spread across the worker threads and the calling thread. Returns once every index
+ * has been processed.
+ *
+ * @note The function must be safe to call concurrently for different indices. It is not copied, so no heap allocation takes place.
+ *
+ * @param i_count The number of indices to process.
+ * @param i_function Callable taking a std::size_t index.
+ */
+template <typename Function> void WorkerPool::parallelFor(std::size_t i_count, Function & i_function) {
+    struct trampoline {
+        static void call(void * i_context, std::size_t i_begin, std::size_t i_end) {
+            Function & function = *static_cast<Function *>(i_context);
+            for (std::size_t i = i_begin; i < i_end; i++) {
+                function(i);
+            }
+        }
+    };
+    run(i_count, &trampoline::call, &i_function);
+}
@@ -2,37 +2,157 @@
 
 #include "sfml/Graphics.hpp"
 #include "Matrix2f.hpp"
+#include <cmath>
 
 /**
  * @brief Some utility functions to interact with sf::Vector2f.
+ *
+ * The vector math is defined inline in this header, so the compiler can inline it into the hot loops of the collision detection and the
+ * solver even without link time optimization. Only the debug output lives in sfml_utility.cpp, so includers don't pull in <iostream>.
+ * SFML 2 vectors aren't literal types, so only functions without sf::Vector2f parameters can be constexpr.
  */
 namespace sfu {
-const float PI = 3.1415926535f;
+constexpr float PI = 3.1415926535f;
+constexpr float DEG_TO_RAD = PI / 180.0f;
+constexpr float RAD_TO_DEG = 180.0f / PI;
 
-sfu::Matrix2f getRotationMatrix(float angle);
+/**
+ * @brief Construct the 2D direct cosine matrix.
+ * @param i_angle The angle in degrees.
+ * @return The rotation matrix.
+ */
+inline Matrix2f getRotationMatrix(float i_angle) {
+    i_angle = i_angle * PI / 180;
+    float cosA = std::cos(i_angle);
+    float sinA = std::sin(i_angle);
+    return Matrix2f(cosA, -sinA, sinA, cosA);
+}
 
-float getVectorLength(sf::Vector2f i_vector);
+/**
+ * @brief Calculate the length of a 2D vector.
+ * @param i_vector The vector.
+ * @return The length in pixels.
+ */
+inline float getVectorLength(sf::Vector2f i_vector) {
+    return std::sqrt(i_vector.x * i_vector.x + i_vector.y * i_vector.y);
+}
 
-float getVectorDirection(sf::Vector2f i_vector);
+/**
+ * @brief Calculate the direction of a 2D vector.
+ * @param i_vector The vector.
+ * @return The angle in degrees.
+ */
+inline float getVectorDirection(sf::Vector2f i_vector) {
+    return std::atan2(i_vector.y, i_vector.x) * 180 / PI;
+}
 
-sf::Vector2f scaleVector(sf::Vector2f i_vector, float factor);
+/**
+ * @brief Multiply a 2D vector with a scalar value.
+ * @param i_vector The vector.
+ * @param factor The factor to multiply the vector with.
+ * @return The scaled vector.
+ */
+inline sf::Vector2f scaleVector(sf::Vector2f i_vector, float factor) {
+    return sf::Vector2f(i_vector.x * factor, i_vector.y * factor);
+}
 
-sf::Vector2f normalizeVector(sf::Vector2f i_vector);
+/**
+ * @brief Normalize a 2D vector to unit length.
+ * @param i_vector The vector.
+ * @return The normalized vector.
+ */
+inline sf::Vector2f normalizeVector(sf::Vector2f i_vector) {
+    float vectorLength = getVectorLength(i_vector);
+    if (vectorLength != 0) {
+        return scaleVector(i_vector, 1 / vectorLength);
+    } else {
+        return sf::Vector2f(0.0f, 0.0f);
+    }
+}
 
-sf::Vector2f addVectors(sf::Vector2f i_vec1, sf::Vector2f i_vec2);
+/**
+ * @brief Add two 2D vectors.
+ * @param i_vec1 The first vector.
+ * @param i_vec2 The second vector.
+ * @return The resulting vector.
+ */
+inline sf::Vector2f addVectors(sf::Vector2f i_vec1, sf::Vector2f i_vec2) {
+    return sf::Vector2f(i_vec1.x + i_vec2.x, i_vec1.y + i_vec2.y);
+}
 
-sf::Vector2f subtractVectors(sf::Vector2f vec1, sf::Vector2f vec2);
+/**
+ * @brief Subtract two 2D vectors.
+ * @param i_vec1 The first vector.
+ * @param i_vec2 The second vector.
+ * @return The resulting vector.
+ */
+inline sf::Vector2f subtractVectors(sf::Vector2f i_vec1, sf::Vector2f i_vec2) {
+    return sf::Vector2f(i_vec1.x - i_vec2.x, i_vec1.y - i_vec2.y);
+}
 
-float scalarProduct(sf::Vector2f i_vec1, sf::Vector2f i_vec2);
+/**
+ * @brief Calculate the scalar product of two 2D vectors.
+ * @param i_vec1 The first vector.
+ * @param i_vec2 The second vector.
+ * @return The scalar product.
+ */
+inline float scalarProduct(sf::Vector2f i_vec1, sf::Vector2f i_vec2) {
+    return i_vec1.x * i_vec2.x + i_vec1.y * i_vec2.y;
+}
 
-float pseudoCrossProduct(sf::Vector2f i_vec1, sf::Vector2f i_vec2);
+/**
+ * @brief Calculate the pseudo cross product for two vectors.
+ * @param i_vec1 The first vector.
+ * @param i_vec2 The second vector.
+ * @return The z-Component of the resulting vector.
+ */
+inline float pseudoCrossProduct(sf::Vector2f i_vec1, sf::Vector2f i_vec2) {
+    return i_vec1.x * i_vec2.y - i_vec1.y * i_vec2.x;
+}
 
-sf::Vector2f pseudoCrossProduct(float i_length1, sf::Vector2f i_vec2);
+/**
+ * @brief Calculate the pseudo cross product for two vectors.
+ * @param i_length1 The z-Component of the first vector.
+ * @param i_vec2 The second vector.
+ * @return The resulting vector.
+ */
+inline sf::Vector2f pseudoCrossProduct(float i_length1, sf::Vector2f i_vec2) {
+    return sf::Vector2f(-i_length1 * i_vec2.y, i_length1 * i_vec2.x);
+}
 
-sf::Vector2f rotateVector(sf::Vector2f i_vector, float i_angle);
+/**
+ * @brief Rotate a vector using multiplication with a DCM.
+ * @param i_vector The vector to rotate.
+ * @param i_angle The rotation angle.
+ * @return The rotated vector.
+ */
+inline sf::Vector2f rotateVector(sf::Vector2f i_vector, float i_angle) {
+    // multiply with rotation matrix
+    return getRotationMatrix(i_angle).multiply(i_vector);
+}
+
+/**
+ * @brief Rotate a vector with the cosine and sine of the rotation angle, e.g. if they have been computed once for many vectors.
+ * @param i_vector The vector to rotate.
+ * @param i_cos Cosine of the rotation angle.
+ * @param i_sin Sine of the rotation angle.
+ * @return The rotated vector.
+ */
+inline sf::Vector2f rotateVector(sf::Vector2f i_vector, float i_cos, float i_sin) {
+    return sf::Vector2f(i_cos * i_vector.x - i_sin * i_vector.y, i_sin * i_vector.x + i_cos * i_vector.y);
+}
 
-sf::Vector2f transformPoint(sf::Vector2f i_vector, sf::Vector2f i_origin, float i_angle);
+/**
+ * @brief Transform a point to a different coordinate system.
+ * @param i_vector The coordinates of the point to transform.
+ * @param i_origin The origin of the new coordinate system given in coordinates of the old coordinate system.
+ * @param i_angle The angle of the new coordinate system relative to the old coordinate system.
+ * @return The coordinates of the transformed point.
+ */
+inline sf::Vector2f transformPoint(sf::Vector2f i_vector, sf::Vector2f i_origin, float i_angle) {
+    return addVectors(rotateVector(i_vector, i_angle), i_origin);
+}
 
 void printVectorCoords(sf::Vector2f i_vector);
 
-} // namespace sfu
\ No newline at end of file
+} // namespace sfu
@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+#include "AllocationTracker.hpp"
+
+// Allocations and deallocations are added to the live bytes of their subsystem, and the peak remembers the largest value
+TEST(AllocationTrackerTest, LiveAndPeakBytesPerSubsystem) {
+    subsystemMemory before = AllocationTracker::getMemory(memorySubsystem::rendering);
+    std::uint64_t totalAllocationCount = AllocationTracker::getAllocationCount();
+
+    AllocationTracker::recordAllocation(memorySubsystem::rendering, 1000);
+    AllocationTracker::recordAllocation(memorySubsystem::rendering, 500);
+    AllocationTracker::recordDeallocation(memorySubsystem::rendering, 1000);
+    subsystemMemory after = AllocationTracker::getMemory(memorySubsystem::rendering);
+    EXPECT_EQ(after.allocationCount - before.allocationCount, 2u);
+    EXPECT_EQ(after.deallocationCount - before.deallocationCount, 1u);
+    EXPECT_EQ(after.liveBytes - before.liveBytes, 500u);
+    EXPECT_GE(after.peakBytes, before.liveBytes + 1500);
+    EXPECT_GE(AllocationTracker::getAllocationCount() - totalAllocationCount, 2u);
+
+    AllocationTracker::recordDeallocation(memorySubsystem::rendering, 500);
+    EXPECT_EQ(AllocationTracker::getMemory(memorySubsystem::rendering).liveBytes, before.liveBytes);
+    EXPECT_STREQ(AllocationTracker::getSubsystemName(memorySubsystem::rendering), "rendering");
+}
+
+// Nested scopes attribute allocations to the innermost subsystem and restore the outer one when they end
+TEST(AllocationTrackerTest, ScopesNest) {
+    EXPECT_EQ(AllocationTracker::getCurrentSubsystem(), memorySubsystem::other);
+    {
+        MemoryScope bodies(memorySubsystem::bodies);
+        EXPECT_EQ(AllocationTracker::getCurrentSubsystem(), memorySubsystem::bodies);
+        {
+            MemoryScope shapes(memorySubsystem::shapes);
+            EXPECT_EQ(AllocationTracker::getCurrentSubsystem(), memorySubsystem::shapes);
+        }
+        EXPECT_EQ(AllocationTracker::getCurrentSubsystem(), memorySubsystem::bodies);
+    }
+    EXPECT_EQ(AllocationTracker::getCurrentSubsystem(), memorySubsystem::other);
+    EXPECT_GT(AllocationTracker::getPeakResidentBytes(), 0u);
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "BodyStore.hpp"
+#include "Circle.hpp"
+#include "Polygon.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace {
+/// Counts how many instances exist, so the test can check that every body gets destroyed exactly once.
+class countedCircle : public Circle {
+  public:
+    explicit countedCircle(int & io_instanceCount) : m_instanceCount(io_instanceCount) {
+        m_instanceCount++;
+    }
+    ~countedCircle() {
+        m_instanceCount--;
+    }
+
+  private:
+    int & m_instanceCount;
+};
+} // namespace
+
+TEST(BodyStoreTest, HandlesOfRemovedBodiesAreRejected) {
+    BodyStore store;
+    bodyHandle circle = store.create<Circle>(0.1f, 5.0f);
+    bodyHandle square = store.insert(new Polygon());
+    ASSERT_NE(store.get(circle), nullptr);
+    EXPECT_EQ(store.size(), 2u);
+
+    EXPECT_TRUE(store.remove(circle));
+    EXPECT_FALSE(store.contains(circle));
+    EXPECT_EQ(store.get(circle), nullptr);
+    EXPECT_FALSE(store.remove(circle));
+    EXPECT_EQ(store.size(), 1u);
+
+    // The free slot is reused, but with a new generation
+    bodyHandle newCircle = store.create<Circle>(0.1f, 5.0f);
+    EXPECT_EQ(newCircle.index, circle.index);
+    EXPECT_NE(newCircle, circle);
+    EXPECT_EQ(store.get(circle), nullptr);
+    EXPECT_NE(store.get(newCircle), nullptr);
+    EXPECT_NE(store.get(square), nullptr);
+    EXPECT_EQ(store.get(bodyHandle()), nullptr);
+}
+
+// Remove bodies in random order, the dense array must always hold exactly the remaining bodies
+TEST(BodyStoreTest, RemovingKeepsBodiesDense) {
+    const int BODY_COUNT = 200;
+    int instanceCount = 0;
+    {
+        BodyStore store;
+        std::vector<bodyHandle> handles;
+        for (int i = 0; i < BODY_COUNT; i++) {
+            handles.push_back(store.create<countedCircle>(instanceCount));
+            store.get(handles.back())->setPosition(static_cast<float>(i), 0.0f);
+        }
+        EXPECT_EQ(instanceCount, BODY_COUNT);
+
+        for (int i = 0; i < BODY_COUNT; i += 3) {
+            EXPECT_TRUE(store.remove(handles[(i * 7) % BODY_COUNT]));
+        }
+        // Removing by pointer must only remove that body
+        RigidBody * body = store.get(handles[1]);
+        ASSERT_NE(body, nullptr);
+        EXPECT_TRUE(store.remove(body));
+        EXPECT_FALSE(store.remove(body));
+
+        EXPECT_EQ(instanceCount, static_cast<int>(store.size()));
+        for (std::size_t i = 0; i < store.size(); i++) {
+            EXPECT_EQ(store.get(store.getHandle(i)), store.getBodies()[i]);
+        }
+        for (bodyHandle handle : handles) {
+            RigidBody * remaining = store.get(handle);
+            if (remaining != nullptr) {
+                EXPECT_NE(std::find(store.getBodies().begin(), store.getBodies().end(), remaining), store.getBodies().end());
+            }
+        }
+    }
+    // The destructor destroys the rest
+    EXPECT_EQ(instanceCount, 0);
+}
+
+// Bodies are packed densely: the hot state comes right after the vtable pointer, and pooled blocks are only padded to the heap alignment
+TEST(BodyStoreTest, BodiesArePackedDensely) {
+    BodyStore store;
+    for (int i = 0; i < 3; i++) {
+        for (RigidBody * body : {store.get(store.insert(new Polygon())), store.get(store.create<Circle>(0.1f, 5.0f))}) {
+            std::uintptr_t address = reinterpret_cast<std::uintptr_t>(body);
+            std::uintptr_t stateAddress = reinterpret_cast<std::uintptr_t>(&body->getState());
+            EXPECT_EQ(address % BodyStore::BLOCK_ALIGNMENT, 0u);
+            EXPECT_EQ(stateAddress, address + sizeof(void *));
+        }
+    }
+    EXPECT_LT(sizeof(Circle), 2 * CACHE_LINE_SIZE);
+    EXPECT_LT(sizeof(Polygon), 2 * CACHE_LINE_SIZE);
+}
+
+// Reserving bodies of different types one after the other makes room for all of them, so creating them doesn't move the dense array
+TEST(BodyStoreTest, ReservationsAddUp) {
+    const int BODY_COUNT = 500;
+    BodyStore store;
+    store.reserve<Circle>(BODY_COUNT);
+    store.reserve<Polygon>(BODY_COUNT);
+    RigidBody * const * bodies = store.getBodies().data();
+    for (int i = 0; i < BODY_COUNT; i++) {
+        store.create<Circle>(0.1f, 5.0f);
+        store.create<Polygon>();
+    }
+    EXPECT_EQ(store.size(), 2u * BODY_COUNT);
+    EXPECT_EQ(store.getBodies().data(), bodies);
+}
+
+// While changes are deferred, the dense array stays untouched; queued additions and removals are applied together afterwards
+TEST(BodyStoreTest, DeferredChangesAreAppliedTogether) {
+    const int BODY_COUNT = 100;
+    int instanceCount = 0;
+    BodyStore store;
+    std::vector<bodyHandle> handles;
+    for (int i = 0; i < BODY_COUNT; i++) {
+        handles.push_back(store.create<countedCircle>(instanceCount));
+    }
+    std::vector<RigidBody *> bodiesBefore = store.getBodies();
+
+    store.deferChanges();
+    for (int i = 0; i < BODY_COUNT; i += 2) {
+        EXPECT_TRUE(store.remove(handles[i]));
+    }
+    EXPECT_FALSE(store.remove(handles[0])); // Already queued
+    bodyHandle added = store.create<countedCircle>(instanceCount);
+    bodyHandle addedAndRemoved = store.create<countedCircle>(instanceCount);
+    EXPECT_TRUE(store.remove(store.get(addedAndRemoved)));
+    // Nothing has changed yet, but all handles are valid
+    EXPECT_EQ(store.getBodies(), bodiesBefore);
+    EXPECT_NE(store.get(handles[0]), nullptr);
+    EXPECT_NE(store.get(added), nullptr);
+    EXPECT_EQ(instanceCount, BODY_COUNT + 2);
+
+    store.applyDeferredChanges();
+    EXPECT_EQ(store.size(), static_cast<std::size_t>(BODY_COUNT / 2 + 1));
+    EXPECT_EQ(instanceCount, BODY_COUNT / 2 + 1);
+    EXPECT_FALSE(store.contains(handles[0]));
+    EXPECT_FALSE(store.contains(addedAndRemoved));
+    EXPECT_TRUE(store.contains(handles[1]));
+    for (std::size_t i = 0; i < store.size(); i++) {
+        EXPECT_EQ(store.get(store.getHandle(i)), store.getBodies()[i]);
+    }
+
+    // Changes are immediate again
+    EXPECT_TRUE(store.remove(added));
+    EXPECT_EQ(store.size(), static_cast<std::size_t>(BODY_COUNT / 2));
+}
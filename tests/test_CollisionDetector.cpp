@@ -4,6 +4,8 @@
 #include "CollisionDetector.hpp"
 #include "sfml_utility.hpp"
 #include "Polygon.hpp"
+#include "BoundaryElement.hpp"
+#include "Circle.hpp"
 #include <cmath>
 #include <numbers>
 
@@ -106,6 +108,148 @@ TEST(CollisionDetectorTest, CornerOnEdgeCollision) {
     EXPECT_NEAR_VECTOR(event.getCollisionGeometry().normals[1], sf::Vector2f(-1.0f, 0.0f));
 }
 
+// Test: Distance between separated bodies (used by the continuous collision detection)
+TEST(CollisionDetectorTest, DistanceOfSeparatedBodies) {
+    CollisionDetector & cd = CollisionDetector::getInstance();
+    const float EDGE_LENGTH = 50.0f; // In pixels
+    const float GAP = 10.0f;         // In pixels
+    Polygon polygon1;
+    Polygon polygon2;
+    polygon2.setPosition({EDGE_LENGTH + GAP, 0.0f});
+    bodyDistance distance = cd.calculateDistance(&polygon1, &polygon2);
+    EXPECT_NEAR(distance.distance, GAP, EPSILON);
+    EXPECT_NEAR(distance.firstPoint.x, EDGE_LENGTH / 2, EPSILON);
+    EXPECT_NEAR(distance.secondPoint.x, EDGE_LENGTH / 2 + GAP, EPSILON);
+
+    // A circle in front of the corner of the square
+    Circle circle(0.1f, 5.0f);
+    circle.setPosition({EDGE_LENGTH / 2 + 3.0f, EDGE_LENGTH / 2 + 4.0f});
+    distance = cd.calculateDistance(&polygon1, &circle);
+    EXPECT_NEAR(distance.distance, 0.0f, EPSILON); // 3-4-5 triangle, the circle touches the corner
+    circle.move(3.0f, 4.0f);
+    distance = cd.calculateDistance(&polygon1, &circle);
+    EXPECT_NEAR(distance.distance, 5.0f, EPSILON);
+    EXPECT_NEAR_VECTOR(distance.firstPoint, sf::Vector2f(EDGE_LENGTH / 2, EDGE_LENGTH / 2));
+}
+
+// Test: A fast circle would pass a thin wall within a single time step
+TEST(CollisionDetectorTest, TimeOfImpactPreventsTunneling) {
+    CollisionDetector & cd = CollisionDetector::getInstance();
+    const float WALL_X = 100.0f;     // In pixels
+    const float RADIUS = 5.0f;       // In pixels
+    const float SPEED = 10000.0f;    // In pixels per second
+    const float DT = 1.0f / 60.0f;   // In seconds
+    const float HALF_THICKNESS = 1.0f; // In pixels
+    // A BoundaryElement is one-sided and would notice the circle behind it, so use a thin immovable Polygon with its face at WALL_X
+    Polygon wall(0.0f, {sf::Vector2f(HALF_THICKNESS, -100.0f), sf::Vector2f(-HALF_THICKNESS, -100.0f),
+                               sf::Vector2f(-HALF_THICKNESS, 100.0f), sf::Vector2f(HALF_THICKNESS, 100.0f)});
+    wall.setPosition({WALL_X + HALF_THICKNESS, 0.0f});
+    Circle bullet(0.1f, RADIUS);
+    bullet.setVelocity({SPEED, 0.0f});
+
+    // Discrete detection doesn't notice anything, neither now nor after the time step
+    EXPECT_GT(cd.generateCollisionEvent(&bullet, &wall).getMinSeparation(), 0.0f);
+    bullet.setPosition({SPEED * DT, 0.0f});
+    EXPECT_GT(cd.generateCollisionEvent(&bullet, &wall).getMinSeparation(), 0.0f);
+    bullet.setPosition({0.0f, 0.0f});
+    impactData impact = cd.calculateTimeOfImpact(&bullet, &wall, DT);
+    ASSERT_TRUE(impact.hasImpact);
+    EXPECT_NEAR(impact.time, (WALL_X - RADIUS) / SPEED, 0.5f / SPEED);
+    EXPECT_NEAR(impact.geometry.normals[0].x, 1.0f, EPSILON);
+    EXPECT_NEAR(impact.geometry.location.x, WALL_X, 0.5f);
+    // The body itself must not have been moved
+    EXPECT_NEAR_VECTOR(bullet.getPosition(), sf::Vector2f(0.0f, 0.0f));
+
+    // Moving away from the wall
+    bullet.setVelocity({-SPEED, 0.0f});
+    EXPECT_FALSE(cd.calculateTimeOfImpact(&bullet, &wall, DT).hasImpact);
+}
 
+// Test: A fast spinning circle makes the conservative advancement take tiny steps, so it runs out of iterations before it reaches the wall
+TEST(CollisionDetectorTest, TimeOfImpactIsConservativeWhenIterationsRunOut) {
+    CollisionDetector & cd = CollisionDetector::getInstance();
+    const float WALL_X = 100.0f;            // In pixels
+    const float RADIUS = 5.0f;              // In pixels
+    const float SPEED = 1000.0f;            // In pixels per second
+    const float ANGULAR_VELOCITY = 3000.0f; // In radians per second
+    const float MAX_TIME = 1.0f;            // In seconds
+    BoundaryElement wall(200.0f);
+    wall.setPosition({WALL_X, 0.0f});
+    wall.setRotation(90.0f);
+    Circle bullet(0.1f, RADIUS);
+    bullet.setVelocity({SPEED, 0.0f});
+    bullet.setAngularVelocityRadians(ANGULAR_VELOCITY);
+
+    // The impact is reported early, but never after the body has touched the wall
+    impactData impact = cd.calculateTimeOfImpact(&bullet, &wall, MAX_TIME);
+    ASSERT_TRUE(impact.hasImpact);
+    EXPECT_GT(impact.time, 0.0f);
+    EXPECT_LT(impact.time, (WALL_X - RADIUS) / SPEED);
+    EXPECT_NEAR(impact.geometry.normals[0].x, 1.0f, EPSILON);
+}
 
+// Test: Speculative contacts stop a fast circle in front of a thin wall without any substeps
+TEST(CollisionDetectorTest, SpeculativeContactPreventsTunneling) {
+    CollisionDetector & cd = CollisionDetector::getInstance();
+    const float WALL_X = 100.0f;     // In pixels
+    const float RADIUS = 5.0f;       // In pixels
+    const float SPEED = 10000.0f;    // In pixels per second
+    const float DT = 1.0f / 60.0f;   // In seconds
+    BoundaryElement wall(200.0f);
+    wall.setPosition({WALL_X, 0.0f});
+    wall.setRotation(90.0f);
+    Circle ball(0.1f, RADIUS);
+
+    // Too slow to reach the wall within the time step
+    ball.setVelocity({10.0f, 0.0f});
+    CollisionEvent event = cd.generateSpeculativeCollisionEvent(&ball, &wall, DT);
+    EXPECT_FALSE(event.isSpeculative());
+    EXPECT_GT(event.getMinSeparation(), 0.0f);
+
+    ball.setVelocity({SPEED, 0.0f});
+    event = cd.generateSpeculativeCollisionEvent(&ball, &wall, DT);
+    ASSERT_TRUE(event.isSpeculative());
+    EXPECT_NEAR(event.getMinSeparation(), WALL_X - RADIUS, 0.5f);
+    EXPECT_EQ(event.resolve(), resolveResult::resolved);
+    // Only the approaching velocity is removed, the ball exactly closes the gap and doesn't bounce
+    EXPECT_NEAR(ball.getVelocity().x, (WALL_X - RADIUS) / DT, 1.0f);
+    ball.updateBody(DT);
+    EXPECT_LT(ball.getPosition().x + RADIUS, WALL_X + 0.5f);
+}
 
+// Every collision check is counted by shape pair, the SAT counts its axes and projected vertices
+TEST(CollisionDetectorTest, CountersTrackWork) {
+    CollisionDetector & cd = CollisionDetector::getInstance();
+    Polygon square1;
+    Polygon square2;
+    Circle circle1(0.1f, 10.0f);
+    Circle circle2(0.1f, 10.0f);
+    BoundaryElement floor(100.0f);
+    square2.setPosition(30.0f, 0.0f);
+    square2.setRotation(20.0f);
+    circle2.setPosition(100.0f, 0.0f);
+
+    cd.resetCounters();
+    cd.generateCollisionEvent(&square1, &square2);
+    narrowphaseCounters counters = cd.getCounters();
+    EXPECT_EQ(counters.polygonPolygonCount, 1u);
+    // Both directions of the SAT, four axes and up to four vertices per axis each
+    EXPECT_EQ(counters.satAxisCount, 8u);
+    EXPECT_GT(counters.projectedVertexCount, 0u);
+    EXPECT_LE(counters.projectedVertexCount, 32u);
+
+    cd.generateCollisionEvent(&circle1, &square1);
+    cd.generateCollisionEvent(&circle1, &circle2);
+    cd.generateCollisionEvent(&floor, &circle1);
+    cd.generateCollisionEvent(&square1, &floor);
+    counters = cd.getCounters();
+    EXPECT_EQ(counters.polygonCircleCount, 1u);
+    EXPECT_EQ(counters.circleCircleCount, 1u);
+    EXPECT_EQ(counters.segmentCircleCount, 1u);
+    EXPECT_EQ(counters.segmentPolygonCount, 1u);
+    EXPECT_GT(counters.satAxisCount, 8u);
+
+    cd.resetCounters();
+    EXPECT_EQ(cd.getCounters().polygonPolygonCount, 0u);
+    EXPECT_EQ(cd.getCounters().projectedVertexCount, 0u);
+}
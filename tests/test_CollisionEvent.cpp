@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "CollisionDetector.hpp"
+#include "sfml_utility.hpp"
+#include "Polygon.hpp"
+#include "Circle.hpp"
+#include <array>
+
+namespace {
+const float EPSILON = 1e-4f; // Tolerance for floating-point comparisons
+
+/**
+ * @brief The resolution math as it was before resolve() worked in the normal frame: the normal is converted to an angle, and the impulse
+ * (j, 0) is rotated back by that angle.
+ */
+void resolveWithAngleRoundTrip(const CollisionEvent & i_event) {
+    const collisionGeometry & geometry = i_event.getCollisionGeometry();
+    std::array<RigidBody *, 2> bodies = i_event.getCollisionPartners();
+    std::array<sf::Vector2f, 2> relativePositions;
+    float contactSpeed = 0.0f;
+    float deltaVelPerUnitImpulse = 0.0f;
+    for (int i = 0; i < 2; i++) {
+        relativePositions[i] = sfu::subtractVectors(geometry.location, bodies[i]->getPosition());
+        float angVel = bodies[i]->getAngularVelocity() * sfu::PI / 180;
+        sf::Vector2f closingVel = sfu::addVectors(sfu::pseudoCrossProduct(angVel, relativePositions[i]), bodies[i]->getVelocity());
+        contactSpeed += sfu::scalarProduct(closingVel, geometry.normals[i]);
+        float angVelPerUnitImpulse =
+                bodies[i]->getInverseMomentOfInertia() * sfu::pseudoCrossProduct(relativePositions[i], geometry.normals[i]);
+        sf::Vector2f velPerUnitImpulse = sfu::pseudoCrossProduct(angVelPerUnitImpulse, relativePositions[i]);
+        deltaVelPerUnitImpulse += sfu::scalarProduct(velPerUnitImpulse, geometry.normals[i]);
+        deltaVelPerUnitImpulse += bodies[i]->getInverseMass();
+    }
+    if (contactSpeed <= 0) {
+        return;
+    }
+    float restitutionCoefficient = bodies[0]->getRestitutionCoefficient() * bodies[1]->getRestitutionCoefficient();
+    float impulseContactX = -contactSpeed * (1 + restitutionCoefficient) / deltaVelPerUnitImpulse;
+    float contactTransformationAngle = sfu::getVectorDirection(geometry.normals[0]);
+    sf::Vector2f impulse = sfu::rotateVector(sf::Vector2f(impulseContactX, 0.0f), contactTransformationAngle);
+    bodies[0]->applyImpulse(relativePositions[0], impulse);
+    bodies[1]->applyImpulse(relativePositions[1], sfu::scaleVector(impulse, -1.0f));
+}
+
+void EXPECT_SAME_MOTION(const RigidBody & i_body1, const RigidBody & i_body2) {
+    EXPECT_NEAR(i_body1.getVelocity().x, i_body2.getVelocity().x, EPSILON);
+    EXPECT_NEAR(i_body1.getVelocity().y, i_body2.getVelocity().y, EPSILON);
+    EXPECT_NEAR(i_body1.getAngularVelocity(), i_body2.getAngularVelocity(), EPSILON);
+}
+} // namespace
+
+// Rotated squares hitting each other at different angles, so the normal points in all directions
+TEST(CollisionEventTest, NormalFrameMatchesAngleRoundTrip) {
+    CollisionDetector & cd = CollisionDetector::getInstance();
+    const float EDGE_LENGTH = 50.0f; // In pixels
+    for (int step = 0; step < 24; step++) {
+        float direction = step * 15.0f + 7.0f; // In degrees
+        sf::Vector2f offset = sfu::rotateVector(sf::Vector2f(EDGE_LENGTH - 2.0f, 5.0f), direction);
+        std::array<Polygon, 2> expected;
+        std::array<Polygon, 2> actual;
+        for (std::array<Polygon, 2> * bodies : {&expected, &actual}) {
+            (*bodies)[0].setPosition(0.0f, 0.0f);
+            (*bodies)[0].setRotation(direction);
+            (*bodies)[0].setVelocity(sfu::rotateVector(sf::Vector2f(30.0f, -4.0f), direction));
+            (*bodies)[0].setAngularVelocity(12.0f);
+            (*bodies)[1].setPosition(offset);
+            (*bodies)[1].setRotation(direction + 10.0f);
+            (*bodies)[1].setVelocity(sfu::rotateVector(sf::Vector2f(-20.0f, 3.0f), direction));
+        }
+        CollisionEvent expectedEvent = cd.generateCollisionEvent(&expected[0], &expected[1]);
+        CollisionEvent actualEvent = cd.generateCollisionEvent(&actual[0], &actual[1]);
+        ASSERT_LE(actualEvent.getMinSeparation(), 0.0f);
+
+        resolveWithAngleRoundTrip(expectedEvent);
+        EXPECT_EQ(actualEvent.resolve(), resolveResult::resolved);
+
+        EXPECT_SAME_MOTION(expected[0], actual[0]);
+        EXPECT_SAME_MOTION(expected[1], actual[1]);
+    }
+}
+
+TEST(CollisionEventTest, SeparatingBodiesAreNotChanged) {
+    CollisionDetector & cd = CollisionDetector::getInstance();
+    Circle circle1;
+    Circle circle2;
+    circle2.setPosition(circle1.getRadius() * 2 - 1.0f, 0.0f);
+    circle1.setVelocity(sf::Vector2f(-10.0f, 0.0f));
+    CollisionEvent event = cd.generateCollisionEvent(&circle1, &circle2);
+
+    EXPECT_EQ(event.resolve(), resolveResult::separating);
+    EXPECT_NEAR(circle1.getVelocity().x, -10.0f, EPSILON);
+    EXPECT_NEAR(circle2.getVelocity().x, 0.0f, EPSILON);
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include "ContactSolver.hpp"
+#include "WideContactSolver.hpp"
+#include "CollisionDetector.hpp"
+#include "BoundaryElement.hpp"
+#include "Circle.hpp"
+#include "Polygon.hpp"
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace {
+const float EPSILON = 1e-5f; // Tolerance for floating-point comparisons
+const float RADIUS = 25.0f;  // In pixels
+
+// A row of overlapping circles moving towards each other, resting on a single BoundaryElement
+struct circleRow {
+    std::vector<std::unique_ptr<Circle>> circles;
+    BoundaryElement floor{100000.0f};
+    FrameArena arena;
+
+    explicit circleRow(int i_count) {
+        floor.setPosition(0.0f, RADIUS - 1.0f);
+        floor.setRotation(180.0f);
+        for (int i = 0; i < i_count; i++) {
+            circles.emplace_back(new Circle(0.1f, RADIUS));
+            // Overlap neighbours by one pixel
+            circles.back()->setPosition(i * (2 * RADIUS - 1.0f), 0.0f);
+            circles.back()->setVelocity(sf::Vector2f(i % 2 == 0 ? 10.0f : -10.0f, 5.0f + i % 3));
+        }
+    }
+
+    // Detect all contacts like Simulation::step() does and resolve them
+    void solve(ContactSolver & i_solver, WorkerPool & i_workerPool) {
+        CollisionDetector & cd = CollisionDetector::getInstance();
+        arena.reset();
+        i_solver.beginStep(arena, circles.size());
+        for (std::size_t i = 0; i < circles.size(); i++) {
+            for (std::size_t j = 0; j < i; j++) {
+                CollisionEvent event = cd.generateCollisionEvent(circles[j].get(), circles[i].get());
+                if (event.getMinSeparation() <= 0) {
+                    i_solver.addContact(event, j, i);
+                }
+            }
+            CollisionEvent event = cd.generateCollisionEvent(&floor, circles[i].get());
+            if (event.getMinSeparation() <= 0) {
+                i_solver.addContact(event, ContactSolver::STATIC_BODY, i);
+            }
+        }
+        i_solver.solve(i_workerPool);
+    }
+};
+} // namespace
+
+// Every circle touches its two neighbours and the floor. The floor itself never causes a conflict, so three colors are enough.
+TEST(ContactSolverTest, ColorsRowWithThreeColors) {
+    circleRow row(10);
+    ContactSolver solver;
+    WorkerPool serialPool(0);
+    row.solve(solver, serialPool);
+
+    EXPECT_EQ(solver.getContactCount(), 9u + 10u);
+    EXPECT_EQ(solver.getColorCount(), 3u);
+}
+
+// Contacts of the same color don't share any movable bodies, so the thread count must not change the result
+TEST(ContactSolverTest, ParallelSolveMatchesSerialSolve) {
+    const int BODY_COUNT = 500; // Enough contacts per color to actually use the worker threads
+    circleRow serialRow(BODY_COUNT);
+    circleRow parallelRow(BODY_COUNT);
+    ContactSolver serialSolver;
+    ContactSolver parallelSolver;
+    WorkerPool serialPool(0);
+    WorkerPool parallelPool(4);
+
+    serialRow.solve(serialSolver, serialPool);
+    parallelRow.solve(parallelSolver, parallelPool);
+
+    for (int i = 0; i < BODY_COUNT; i++) {
+        EXPECT_NEAR(serialRow.circles[i]->getVelocity().x, parallelRow.circles[i]->getVelocity().x, EPSILON);
+        EXPECT_NEAR(serialRow.circles[i]->getVelocity().y, parallelRow.circles[i]->getVelocity().y, EPSILON);
+        EXPECT_NEAR(serialRow.circles[i]->getAngularVelocity(), parallelRow.circles[i]->getAngularVelocity(), EPSILON);
+    }
+    // The floor has infinite mass and must not have been changed by any of the contacts
+    EXPECT_NEAR(parallelRow.floor.getVelocity().x, 0.0f, EPSILON);
+    EXPECT_NEAR(parallelRow.floor.getVelocity().y, 0.0f, EPSILON);
+}
+
+// Two static bodies can't be pushed apart. The contact must be reported instead of changing the bodies.
+TEST(ContactSolverTest, CountsDegenerateContacts) {
+    circleRow row(2);
+    for (std::unique_ptr<Circle> & circle : row.circles) {
+        circle.reset(new Circle(0.0f, RADIUS)); // Infinite mass
+    }
+    row.circles[0]->setPosition(0.0f, 0.0f);
+    row.circles[1]->setPosition(2 * RADIUS - 1.0f, 0.0f);
+    row.circles[0]->setVelocity(sf::Vector2f(10.0f, 0.0f));
+    ContactSolver solver;
+    WorkerPool serialPool(0);
+    row.solve(solver, serialPool);
+
+    CollisionEvent event = CollisionDetector::getInstance().generateCollisionEvent(row.circles[0].get(), row.circles[1].get());
+    EXPECT_EQ(event.resolve(), resolveResult::degenerate);
+    EXPECT_EQ(solver.getDegenerateContactCount(), 1u);
+    EXPECT_NEAR(row.circles[0]->getVelocity().x, 10.0f, EPSILON);
+}
+
+// Every SIMD level must give the same result as resolving the contacts one by one. The pairs of boxes don't share any bodies, so they
+// can all go into one batch. Every third pair doesn't touch yet and gets a speculative contact.
+TEST(WideContactSolverTest, BatchMatchesSingleResolve) {
+    const int PAIR_COUNT = 19; // Covers full batches and a partial one for all lane counts
+    const float DT = 1.0f;     // In seconds, long enough for the separated pairs to close the gap
+    CollisionDetector & cd = CollisionDetector::getInstance();
+    for (simdLevel level : {simdLevel::scalar, simdLevel::sse, simdLevel::avx2}) {
+        WideContactSolver wideSolver(level);
+        std::vector<std::unique_ptr<Polygon>> singleBoxes;
+        std::vector<std::unique_ptr<Polygon>> wideBoxes;
+        std::vector<CollisionEvent> singleEvents;
+        std::vector<CollisionEvent> wideEvents;
+        for (std::vector<std::unique_ptr<Polygon>> * boxes : {&singleBoxes, &wideBoxes}) {
+            for (int i = 0; i < 2 * PAIR_COUNT; i++) {
+                boxes->emplace_back(new Polygon(0.1f + 0.01f * i));
+                // The second box of a pair is tilted and hits the face of the first one with a corner away from its center of mass, so the
+                // contact normal doesn't go through the centers and the impulse has a torque
+                float gap = (i / 2) % 3 == 0 ? 3.0f : -2.0f;
+                boxes->back()->setPosition(500.0f * (i / 2) + (i % 2) * (25.0f + 25.0f * std::sqrt(2.0f) + gap), (i % 2) * (10.0f + i % 7));
+                boxes->back()->setRotation((i % 2) * 45.0f);
+                boxes->back()->setVelocity(sf::Vector2f(i % 2 == 0 ? 20.0f : -15.0f, 3.0f * (i % 5)));
+                boxes->back()->setAngularVelocity(10.0f * (i % 3));
+            }
+        }
+        for (int i = 0; i < PAIR_COUNT; i++) {
+            singleEvents.push_back(cd.generateSpeculativeCollisionEvent(singleBoxes[2 * i].get(), singleBoxes[2 * i + 1].get(), DT));
+            wideEvents.push_back(cd.generateSpeculativeCollisionEvent(wideBoxes[2 * i].get(), wideBoxes[2 * i + 1].get(), DT));
+            EXPECT_EQ(wideEvents.back().isSpeculative(), i % 3 == 0);
+        }
+
+        std::vector<CollisionEvent *> wideEventPointers;
+        for (int i = 0; i < PAIR_COUNT; i++) {
+            singleEvents[i].resolve();
+            wideEventPointers.push_back(&wideEvents[i]);
+        }
+        wideSolver.solve(wideEventPointers.data(), wideEventPointers.size());
+        // Make sure the contacts actually changed the linear and the angular velocities
+        EXPECT_LT(singleBoxes[0]->getVelocity().x, 20.0f);
+        EXPECT_GT(std::abs(singleBoxes[0]->getAngularVelocity()), 1.0f);
+
+        for (int i = 0; i < 2 * PAIR_COUNT; i++) {
+            EXPECT_NEAR(singleBoxes[i]->getVelocity().x, wideBoxes[i]->getVelocity().x, 1e-3f)
+                    << WideContactSolver::getSimdLevelName(level);
+            EXPECT_NEAR(singleBoxes[i]->getVelocity().y, wideBoxes[i]->getVelocity().y, 1e-3f)
+                    << WideContactSolver::getSimdLevelName(level);
+            EXPECT_NEAR(singleBoxes[i]->getAngularVelocity(), wideBoxes[i]->getAngularVelocity(), 1e-3f)
+                    << WideContactSolver::getSimdLevelName(level);
+        }
+    }
+}
+
+TEST(WorkerPoolTest, ProcessesEveryIndexOnce) {
+    WorkerPool pool(3);
+    std::vector<int> visits(10000, 0);
+    auto visit = [&visits](std::size_t i_index) { visits[i_index]++; };
+    for (int run = 0; run < 3; run++) {
+        pool.parallelFor(visits.size(), visit);
+    }
+    for (int count : visits) {
+        EXPECT_EQ(count, 3);
+    }
+}
@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+#include "FrameArena.hpp"
+#include <cstdint>
+
+TEST(FrameArenaTest, AllocationsAreAligned) {
+    FrameArena arena(256);
+    arena.allocate(1, 1);
+    void * pointer = arena.allocate(8, 32);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(pointer) % 32, 0u);
+    double * values = arena.allocateArray<double>(3);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(values) % alignof(double), 0u);
+    EXPECT_GE(arena.getUsedBytes(), 1u + 8u + 3 * sizeof(double));
+}
+
+// A step which doesn't fit into the arena still works, and the arena is large enough for it after the next reset
+TEST(FrameArenaTest, GrowsToHighWaterMark) {
+    const std::size_t INITIAL_CAPACITY = 64;  // In bytes
+    const int ELEMENT_COUNT = 1000;
+    FrameArena arena(INITIAL_CAPACITY);
+    for (int step = 0; step < 3; step++) {
+        arena.reset();
+        FrameArray<int> values;
+        values.reset(arena);
+        for (int i = 0; i < ELEMENT_COUNT; i++) {
+            values.push_back(i);
+        }
+        ASSERT_EQ(values.size(), static_cast<std::size_t>(ELEMENT_COUNT));
+        for (int i = 0; i < ELEMENT_COUNT; i++) {
+            EXPECT_EQ(values[i], i);
+        }
+    }
+    EXPECT_GE(arena.getHighWaterMark(), ELEMENT_COUNT * sizeof(int));
+    EXPECT_GE(arena.getCapacity(), arena.getHighWaterMark());
+    EXPECT_LE(arena.getUsedBytes(), arena.getCapacity());
+
+    arena.reset();
+    EXPECT_EQ(arena.getUsedBytes(), 0u);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "PerformanceHud.hpp"
+#include <chrono>
+#include <vector>
+
+// The overlay consists of whole rectangles, and its size only depends on the text, not on the number of recorded frames
+TEST(PerformanceHudTest, OverlayIsBuiltFromRectangles) {
+    Profiler profiler(10);
+    simulationStats stats;
+    stats.bodyCount = 12;
+    stats.contactCount = 34;
+    PerformanceHud hud;
+    hud.update(profiler, stats, 8000.0f, 8000.0f);
+    std::size_t emptyVertexCount = hud.getVertexCount();
+    EXPECT_GT(emptyVertexCount, 0u);
+    EXPECT_EQ(emptyVertexCount % 6, 0u);
+
+    for (int i = 0; i < 200; i++) {
+        profiler.addTime(profilePhase::solve, std::chrono::microseconds(0));
+        profiler.endFrame();
+        hud.update(profiler, stats, 8000.0f, 8000.0f);
+        EXPECT_EQ(hud.getVertexCount(), emptyVertexCount);
+    }
+}
+
+// The first line shows the wall-clock frame times passed in, not the sum of the profiled phases
+TEST(PerformanceHudTest, FrameLineShowsWallClockFrameTime) {
+    Profiler profiler(10);
+    simulationStats stats;
+    PerformanceHud hud;
+    for (int i = 0; i < 100; i++) {
+        profiler.addTime(profilePhase::solve, std::chrono::microseconds(100));
+        profiler.endFrame();
+        // Every tenth frame takes twice as long
+        hud.update(profiler, stats, i % 10 == 9 ? 2000.0f : 1000.0f, 8000.0f);
+    }
+    const phaseStatistics & frame = hud.getFrameStatistics();
+    EXPECT_EQ(frame.frameCount, 100u);
+    EXPECT_FLOAT_EQ(frame.mean, 1100.0f);
+    EXPECT_FLOAT_EQ(frame.min, 1000.0f);
+    EXPECT_FLOAT_EQ(frame.p99, 2000.0f);
+    EXPECT_FLOAT_EQ(frame.last, 2000.0f);
+
+    // Older frames drop out of the window of the graph
+    for (std::size_t i = 0; i < PerformanceHud::GRAPH_FRAME_COUNT; i++) {
+        hud.update(profiler, stats, 500.0f, 8000.0f);
+    }
+    EXPECT_EQ(hud.getFrameStatistics().frameCount, PerformanceHud::GRAPH_FRAME_COUNT);
+    EXPECT_FLOAT_EQ(hud.getFrameStatistics().max, 500.0f);
+}
+
+// The phase bars start after the text of their line, so even a full bar doesn't cover the last digits of the p99 time
+TEST(PerformanceHudTest, PhaseBarsDontCoverText) {
+    const float FRAME_BUDGET = 8000.0f; // In microseconds
+    Profiler profiler(10);
+    for (std::size_t phase = 0; phase < Profiler::PHASE_COUNT; phase++) {
+        profiler.addTime(static_cast<profilePhase>(phase), std::chrono::microseconds(static_cast<int>(FRAME_BUDGET)));
+    }
+    profiler.endFrame();
+    simulationStats stats;
+    PerformanceHud hud;
+    hud.update(profiler, stats, FRAME_BUDGET, FRAME_BUDGET);
+
+    // Every rectangle is two triangles, the first and third vertex are opposite corners. Glyph pixels are squares of the font scale,
+    // phase bars are as high as a line of text.
+    const sf::VertexArray & vertices = hud.getVertices();
+    sf::FloatRect background(vertices[0].position, vertices[2].position - vertices[0].position);
+    std::vector<sf::FloatRect> glyphPixels;
+    std::vector<sf::FloatRect> bars;
+    for (std::size_t i = 6; i < vertices.getVertexCount(); i += 6) {
+        sf::FloatRect rectangle(vertices[i].position, vertices[i + 2].position - vertices[i].position);
+        if (rectangle.width == 2.0f && rectangle.height == 2.0f) {
+            glyphPixels.push_back(rectangle);
+        } else if (rectangle.height == 10.0f) {
+            bars.push_back(rectangle);
+        }
+    }
+    ASSERT_EQ(bars.size(), Profiler::PHASE_COUNT);
+    for (const sf::FloatRect & bar : bars) {
+        EXPECT_GT(bar.width, 0.0f);
+        EXPECT_LE(bar.left + bar.width, background.left + background.width);
+        for (const sf::FloatRect & pixel : glyphPixels) {
+            EXPECT_FALSE(bar.intersects(pixel)) << "bar at y " << bar.top << " covers a pixel at " << pixel.left << "," << pixel.top;
+        }
+    }
+}
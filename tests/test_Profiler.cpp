@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "Profiler.hpp"
+#include <chrono>
+
+namespace {
+Profiler::clock::duration microseconds(int i_count) {
+    return std::chrono::duration_cast<Profiler::clock::duration>(std::chrono::microseconds(i_count));
+}
+} // namespace
+
+// Times added within a frame are summed up, and the statistics cover the frames in the window
+TEST(ProfilerTest, StatisticsCoverTheWindow) {
+    Profiler profiler(100);
+    EXPECT_EQ(profiler.getStatistics(profilePhase::solve).frameCount, 0u);
+
+    // 1, 2, ..., 100 microseconds, the solve phase is timed twice per frame
+    for (int i = 1; i <= 100; i++) {
+        profiler.addTime(profilePhase::solve, microseconds(i - 1));
+        profiler.addTime(profilePhase::solve, microseconds(1));
+        profiler.addTime(profilePhase::render, microseconds(10));
+        profiler.endFrame();
+    }
+    phaseStatistics solve = profiler.getStatistics(profilePhase::solve);
+    EXPECT_EQ(solve.frameCount, 100u);
+    EXPECT_FLOAT_EQ(solve.min, 1.0f);
+    EXPECT_FLOAT_EQ(solve.max, 100.0f);
+    EXPECT_FLOAT_EQ(solve.mean, 50.5f);
+    EXPECT_FLOAT_EQ(solve.p99, 99.0f);
+    EXPECT_FLOAT_EQ(solve.last, 100.0f);
+    EXPECT_FLOAT_EQ(profiler.getFrameStatistics().max, 110.0f);
+    EXPECT_EQ(profiler.getStatistics(profilePhase::events).max, 0.0f);
+
+    // Older frames drop out of the window
+    for (int i = 0; i < 50; i++) {
+        profiler.addTime(profilePhase::solve, microseconds(1000));
+        profiler.endFrame();
+    }
+    solve = profiler.getStatistics(profilePhase::solve);
+    EXPECT_EQ(solve.frameCount, 100u);
+    EXPECT_FLOAT_EQ(solve.min, 51.0f);
+    EXPECT_FLOAT_EQ(solve.max, 1000.0f);
+    EXPECT_EQ(profiler.getFrameCount(), 150u);
+
+    profiler.reset();
+    EXPECT_EQ(profiler.getFrameStatistics().frameCount, 0u);
+}
+
+TEST(ProfilerTest, ScopedTimerAddsElapsedTime) {
+    Profiler profiler;
+    {
+        ScopedTimer timer(profiler, profilePhase::narrowphase);
+        Profiler::clock::time_point start = Profiler::clock::now();
+        while (Profiler::clock::now() - start < std::chrono::microseconds(200)) {}
+    }
+    profiler.endFrame();
+    EXPECT_GE(profiler.getStatistics(profilePhase::narrowphase).last, 200.0f);
+    EXPECT_STREQ(Profiler::getPhaseName(profilePhase::narrowphase), "narrowphase");
+}
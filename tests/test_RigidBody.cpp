@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "sfml_utility.hpp"
+#include "Polygon.hpp"
+#include <algorithm>
+
+namespace {
+const float EPSILON = 1e-4f; // Tolerance for floating-point comparisons
+} // namespace
+
+// The degree based setters are a compatibility layer, the body works with radians internally
+TEST(RigidBodyTest, DegreeSettersConvertToRadians) {
+    Polygon polygon;
+    polygon.setRotation(90.0f);
+    EXPECT_NEAR(polygon.getOrientation(), sfu::PI / 2, EPSILON);
+    EXPECT_NEAR(polygon.getRotation(), 90.0f, EPSILON);
+
+    polygon.rotate(-180.0f);
+    EXPECT_NEAR(polygon.getOrientation(), 3 * sfu::PI / 2, EPSILON);
+    EXPECT_NEAR(polygon.getRotation(), 270.0f, EPSILON);
+
+    polygon.setAngularVelocity(180.0f);
+    EXPECT_NEAR(polygon.getAngularVelocityRadians(), sfu::PI, EPSILON);
+    EXPECT_NEAR(polygon.getAngularVelocity(), 180.0f, EPSILON);
+}
+
+// Global points are computed with the cached cosine and sine, they must match the rotation matrix of sfu
+TEST(RigidBodyTest, CachedRotationMatchesRotationMatrix) {
+    Polygon polygon;
+    polygon.setPosition(40.0f, -10.0f);
+    for (float angle = -350.0f; angle < 400.0f; angle += 37.0f) {
+        polygon.setRotation(angle);
+        for (std::size_t i = 0; i < polygon.getPointCount(); i++) {
+            sf::Vector2f expected = sfu::transformPoint(polygon.getPoints()[i], polygon.getPosition(), angle);
+            EXPECT_NEAR(polygon.getGlobalPoint(i).x, expected.x, EPSILON);
+            EXPECT_NEAR(polygon.getGlobalPoint(i).y, expected.y, EPSILON);
+        }
+    }
+}
+
+// One time step turns the body by angular velocity times dT, the rendered rotation follows
+TEST(RigidBodyTest, UpdateBodyIntegratesOrientation) {
+    const float DT = 0.5f; // In seconds
+    Polygon polygon;
+    polygon.setFrictionCoefficient(0.0f);
+    polygon.setAngularVelocityRadians(sfu::PI / 2);
+    polygon.updateBody(DT);
+
+    EXPECT_NEAR(polygon.getOrientation(), sfu::PI / 4, EPSILON);
+    EXPECT_NEAR(polygon.getRotation(), 45.0f, EPSILON);
+    sf::Vector2f expected = sfu::rotateVector(polygon.getPoints()[0], 45.0f);
+    EXPECT_NEAR(polygon.getGlobalPoint(0).x, expected.x, EPSILON);
+    EXPECT_NEAR(polygon.getGlobalPoint(0).y, expected.y, EPSILON);
+}
+
+// The bounding radius is cached in the hot state, it has to enclose every point of the body
+TEST(RigidBodyTest, CachedBoundingRadiusEnclosesBody) {
+    Polygon polygon;
+    float maxPointDistance = 0.0f;
+    for (const sf::Vector2f & point : polygon.getPoints()) {
+        maxPointDistance = std::max(maxPointDistance, sfu::getVectorLength(point));
+    }
+    EXPECT_NEAR(polygon.getBoundingRadius(), maxPointDistance, EPSILON);
+    EXPECT_EQ(polygon.getState().boundingRadius, polygon.getBoundingRadius());
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "Circle.hpp"
+#include "Polygon.hpp"
+#include "ShapeDefinition.hpp"
+#include "sfml_utility.hpp"
+#include <cmath>
+#include <memory>
+
+namespace {
+const float EPSILON = 1e-4f; // Tolerance for floating-point comparisons
+} // namespace
+
+// A 40x20 rectangle placed off-center: the definition moves it to its center of mass and precalculates everything else
+TEST(ShapeDefinitionTest, PolygonPropertiesAreCalculatedOnce) {
+    std::shared_ptr<const ShapeDefinition> rectangle = ShapeDefinition::createPolygon(
+            {sf::Vector2f(50.0f, 0.0f), sf::Vector2f(10.0f, 0.0f), sf::Vector2f(10.0f, 20.0f), sf::Vector2f(50.0f, 20.0f)});
+
+    EXPECT_NEAR(rectangle->getArea(), 800.0f, EPSILON);
+    EXPECT_NEAR(rectangle->getCenterOfMass().x, 30.0f, EPSILON);
+    EXPECT_NEAR(rectangle->getCenterOfMass().y, 10.0f, EPSILON);
+    EXPECT_NEAR(rectangle->getVertices()[0].x, 20.0f, EPSILON);
+    EXPECT_NEAR(rectangle->getVertices()[0].y, -10.0f, EPSILON);
+    EXPECT_NEAR(rectangle->getBoundingRadius(), std::sqrt(500.0f), EPSILON);
+    // Moment of inertia of a rectangle with unit mass: (w^2 + h^2) / 12
+    EXPECT_NEAR(rectangle->getUnitInverseMomentOfInertia(), 12.0f / 2000.0f, EPSILON);
+
+    // Normals are unit vectors facing away from the center of mass
+    ASSERT_EQ(rectangle->getNormals().size, 4u);
+    for (std::size_t i = 0; i < 4; i++) {
+        const sf::Vector2f & normal = rectangle->getNormals()[i];
+        EXPECT_NEAR(sfu::getVectorLength(normal), 1.0f, EPSILON);
+        EXPECT_GT(sfu::scalarProduct(normal, rectangle->getVertices()[i]), 0.0f);
+    }
+}
+
+// Bodies with different masses can share a definition, only the inertia is scaled by the mass
+TEST(ShapeDefinitionTest, BodiesShareDefinition) {
+    std::shared_ptr<const ShapeDefinition> ball = ShapeDefinition::createCircle(10.0f);
+    Circle light(1.0f, ball);
+    Circle heavy(0.25f, ball);
+
+    EXPECT_EQ(&light.getShape(), &heavy.getShape());
+    EXPECT_NEAR(light.getRadius(), 10.0f, EPSILON);
+    EXPECT_NEAR(light.getInverseMomentOfInertia(), 2.0f / 100.0f, EPSILON);
+    EXPECT_NEAR(heavy.getInverseMomentOfInertia(), 0.25f * 2.0f / 100.0f, EPSILON);
+
+    // Same results as a body which creates its own definition
+    Polygon ownShape;
+    Polygon sharedShape(0.1f, ownShape.getSharedShape());
+    EXPECT_EQ(ownShape.getInverseMomentOfInertia(), sharedShape.getInverseMomentOfInertia());
+    EXPECT_EQ(ownShape.getBoundingRadius(), sharedShape.getBoundingRadius());
+}
+
+// Small shapes are stored inline, larger ones move to the heap without losing vertices. Reading the points never copies them.
+TEST(ShapeDefinitionTest, VerticesAreStoredInline) {
+    Polygon square;
+    EXPECT_EQ(square.getPoints().data, square.getShape().getVertices().data);
+    EXPECT_GE(reinterpret_cast<const char *>(square.getPoints().data), reinterpret_cast<const char *>(&square.getShape()));
+    EXPECT_LT(reinterpret_cast<const char *>(square.getPoints().data), reinterpret_cast<const char *>(&square.getShape() + 1));
+
+    InlineVertexArray vertices;
+    const std::size_t VERTEX_COUNT = InlineVertexArray::INLINE_CAPACITY + 4;
+    for (std::size_t i = 0; i < VERTEX_COUNT; i++) {
+        vertices.push_back(sf::Vector2f(static_cast<float>(i), 0.0f));
+        EXPECT_EQ(vertices.isInline(), i < InlineVertexArray::INLINE_CAPACITY);
+    }
+    ASSERT_EQ(vertices.size(), VERTEX_COUNT);
+    for (std::size_t i = 0; i < VERTEX_COUNT; i++) {
+        EXPECT_EQ(vertices[i].x, static_cast<float>(i));
+    }
+}
@@ -0,0 +1,303 @@
+#include <gtest/gtest.h>
+#include "Simulation.hpp"
+#include "BoundaryElement.hpp"
+#include "Circle.hpp"
+#include "Polygon.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace {
+/// Set while allocations are being counted.
+std::atomic<bool> g_countAllocations{false};
+/// Number of allocations made while g_countAllocations was set.
+std::atomic<std::size_t> g_allocationCount{0};
+} // namespace
+
+// Replace the global allocation functions for the whole test binary, so every allocation of a simulation step (on any thread) is counted.
+// All of them, including the aligned ones used for over-aligned types, go through allocate() and deallocate(), so a block is always freed
+// by the function that matches the one which allocated it.
+namespace {
+/// Stored in front of every aligned block, so deallocate() can find the block returned by malloc.
+struct alignedHeader {
+    void * block;
+};
+
+void * allocate(std::size_t i_size, std::size_t i_alignment) {
+    if (g_countAllocations.load(std::memory_order_relaxed)) {
+        g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (i_alignment <= alignof(std::max_align_t)) {
+        void * pointer = std::malloc(i_size == 0 ? 1 : i_size);
+        if (pointer == nullptr) {
+            throw std::bad_alloc();
+        }
+        return pointer;
+    }
+    // Over-allocate and move the start to the next multiple of the alignment, leaving room for the header
+    void * block = std::malloc(i_size + i_alignment + sizeof(alignedHeader));
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    std::uintptr_t start = reinterpret_cast<std::uintptr_t>(block) + sizeof(alignedHeader);
+    void * pointer = reinterpret_cast<void *>((start + i_alignment - 1) & ~(i_alignment - 1));
+    (static_cast<alignedHeader *>(pointer) - 1)->block = block;
+    return pointer;
+}
+
+void deallocate(void * i_pointer, std::size_t i_alignment) noexcept {
+    if (i_pointer == nullptr) {
+        return;
+    }
+    if (i_alignment <= alignof(std::max_align_t)) {
+        std::free(i_pointer);
+    } else {
+        std::free((static_cast<alignedHeader *>(i_pointer) - 1)->block);
+    }
+}
+} // namespace
+
+void * operator new(std::size_t i_size) {
+    return allocate(i_size, alignof(std::max_align_t));
+}
+
+void * operator new[](std::size_t i_size) {
+    return allocate(i_size, alignof(std::max_align_t));
+}
+
+void * operator new(std::size_t i_size, std::align_val_t i_alignment) {
+    return allocate(i_size, static_cast<std::size_t>(i_alignment));
+}
+
+void * operator new[](std::size_t i_size, std::align_val_t i_alignment) {
+    return allocate(i_size, static_cast<std::size_t>(i_alignment));
+}
+
+void operator delete(void * i_pointer) noexcept {
+    deallocate(i_pointer, alignof(std::max_align_t));
+}
+
+void operator delete[](void * i_pointer) noexcept {
+    deallocate(i_pointer, alignof(std::max_align_t));
+}
+
+void operator delete(void * i_pointer, std::size_t) noexcept {
+    deallocate(i_pointer, alignof(std::max_align_t));
+}
+
+void operator delete[](void * i_pointer, std::size_t) noexcept {
+    deallocate(i_pointer, alignof(std::max_align_t));
+}
+
+void operator delete(void * i_pointer, std::align_val_t i_alignment) noexcept {
+    deallocate(i_pointer, static_cast<std::size_t>(i_alignment));
+}
+
+void operator delete[](void * i_pointer, std::align_val_t i_alignment) noexcept {
+    deallocate(i_pointer, static_cast<std::size_t>(i_alignment));
+}
+
+void operator delete(void * i_pointer, std::size_t, std::align_val_t i_alignment) noexcept {
+    deallocate(i_pointer, static_cast<std::size_t>(i_alignment));
+}
+
+void operator delete[](void * i_pointer, std::size_t, std::align_val_t i_alignment) noexcept {
+    deallocate(i_pointer, static_cast<std::size_t>(i_alignment));
+}
+
+// Once the scene has settled, a step must not allocate anything: all buffers are reused from the previous steps
+TEST(SimulationTest, SteadyStateStepDoesNotAllocate) {
+    const int WARM_UP_STEPS = 10;
+    const int MEASURED_STEPS = 200;
+    const float DT = 1.0f / 120.0f; // In seconds
+    const float RADIUS = 10.0f;     // In pixels
+    Simulation & simulation = Simulation::getInstance();
+    // The simulation keeps a pointer to the floor, so it has to outlive the test
+    static BoundaryElement floor(2000.0f);
+    floor.setPosition(0.0f, 200.0f);
+    simulation.addBoundaryElement(&floor);
+
+    // A pile of circles and squares falling onto the floor and into each other, plus a fast bullet
+    std::vector<RigidBody *> bodies;
+    for (int i = 0; i < 20; i++) {
+        bodies.push_back(new Circle(0.1f, RADIUS));
+        bodies.back()->setPosition(30.0f * i, 180.0f - (i % 3) * 19.0f);
+        bodies.back()->setVelocity(sf::Vector2f(i % 2 == 0 ? 40.0f : -40.0f, 60.0f));
+    }
+    for (int i = 0; i < 10; i++) {
+        bodies.push_back(new Polygon());
+        bodies.back()->setPosition(60.0f * i, 100.0f);
+        bodies.back()->setAngularVelocity(45.0f * (i % 4));
+    }
+    bodies.push_back(new Circle(0.1f, 2.0f));
+    bodies.back()->setPosition(-100.0f, 150.0f);
+    bodies.back()->setVelocity(sf::Vector2f(5000.0f, 0.0f));
+    bodies.back()->setBullet(true);
+    for (RigidBody * body : bodies) {
+        simulation.addCollisionPartner(body);
+    }
+
+    for (int i = 0; i < WARM_UP_STEPS; i++) {
+        simulation.step(DT);
+    }
+    g_allocationCount.store(0);
+    g_countAllocations.store(true);
+    for (int i = 0; i < MEASURED_STEPS; i++) {
+        simulation.step(DT);
+    }
+    g_countAllocations.store(false);
+    EXPECT_GT(simulation.getStats().contactCount, 0u);
+    EXPECT_EQ(g_allocationCount.load(), 0u);
+
+    // The counters describe the last step
+    const simulationStats & stats = simulation.getStats();
+    EXPECT_EQ(stats.integratedBodyCount, bodies.size());
+    EXPECT_GT(stats.narrowphase.segmentCircleCount, 0u);
+    EXPECT_GT(stats.narrowphase.satAxisCount, 0u);
+
+    for (RigidBody * body : bodies) {
+        simulation.deleteCollisionPartner(body);
+    }
+}
+
+// Contacts which are already separating don't get an impulse, and the collision checks of bullets don't count as narrowphase work
+TEST(SimulationTest, StatsCountImpulsesAndNarrowphaseOfKnownScene) {
+    const float DT = 1.0f / 60.0f; // In seconds
+    const float RADIUS = 10.0f;    // In pixels
+    Simulation & simulation = Simulation::getInstance();
+    simulation.m_useSpeculativeContacts = false;
+    std::vector<bodyHandle> handles;
+    auto addCircle = [&](float i_radius, sf::Vector2f i_position, sf::Vector2f i_velocity) {
+        handles.push_back(simulation.createCollisionPartner<Circle>(0.1f, i_radius));
+        simulation.getCollisionPartner(handles.back())->setPosition(i_position);
+        simulation.getCollisionPartner(handles.back())->setVelocity(i_velocity);
+        return simulation.getCollisionPartner(handles.back());
+    };
+    // Two overlapping circles moving towards each other, and two moving apart
+    addCircle(RADIUS, sf::Vector2f(-5000.0f, -5000.0f), sf::Vector2f(10.0f, 0.0f));
+    addCircle(RADIUS, sf::Vector2f(-4982.0f, -5000.0f), sf::Vector2f(-10.0f, 0.0f));
+    addCircle(RADIUS, sf::Vector2f(-5000.0f, -4900.0f), sf::Vector2f(-10.0f, 0.0f));
+    addCircle(RADIUS, sf::Vector2f(-4982.0f, -4900.0f), sf::Vector2f(10.0f, 0.0f));
+    // A bullet passing close to the second pair on its way to a wall it hits within the step
+    addCircle(5.0f, sf::Vector2f(-5000.0f, -4860.0f), sf::Vector2f(5000.0f, 0.0f))->setBullet(true);
+    BoundaryElement wall(40.0f);
+    wall.setPosition(-4940.0f, -4860.0f);
+    wall.setRotation(90.0f);
+    simulation.addBoundaryElement(&wall);
+
+    simulation.step(DT);
+    simulation.removeBoundaryElement(&wall);
+    simulation.m_useSpeculativeContacts = true;
+    for (bodyHandle handle : handles) {
+        simulation.deleteCollisionPartner(handle);
+    }
+
+    const simulationStats & stats = simulation.getStats();
+    EXPECT_EQ(stats.contactCount, 2u);
+    EXPECT_EQ(stats.degenerateContactCount, 0u);
+    EXPECT_EQ(stats.resolvedContactCount, 1u);
+    EXPECT_EQ(stats.bulletImpactCount, 1u);
+    EXPECT_EQ(stats.impulseCount, 2u);
+    // Every pair of the five circles once, the bullet's checks against the circles of the second pair are not included
+    EXPECT_EQ(stats.narrowphase.circleCircleCount, 10u);
+}
+
+// Creating a whole scene at once reserves the memory up front: the number of allocations doesn't grow with the number of bodies
+TEST(SimulationTest, BatchCreationAllocatesOnce) {
+    const int BODY_COUNT = 1000;
+    Simulation & simulation = Simulation::getInstance();
+    std::shared_ptr<const ShapeDefinition> ball = ShapeDefinition::createCircle(5.0f);
+    std::shared_ptr<const ShapeDefinition> crate = Polygon().getSharedShape();
+    std::vector<bodyDefinition> definitions(BODY_COUNT);
+    for (int i = 0; i < BODY_COUNT; i++) {
+        definitions[i].shape = i % 2 == 0 ? ball : crate;
+        definitions[i].position = sf::Vector2f(20.0f * i, 0.0f);
+        definitions[i].angularVelocity = 1.0f;
+    }
+    definitions[1].shape = ShapeDefinition::createSegment(10.0f);
+    definitions[5].shape = nullptr;
+
+    // The first batch reserves the arrays of the store and the simulation and the pooled memory. Deleted bodies leave all of it behind, so
+    // the second batch must not allocate anything but the returned handles.
+    for (bodyHandle handle : simulation.createCollisionPartners(definitions)) {
+        simulation.deleteCollisionPartner(handle);
+    }
+    g_allocationCount.store(0);
+    g_countAllocations.store(true);
+    std::vector<bodyHandle> handles = simulation.createCollisionPartners(definitions);
+    g_countAllocations.store(false);
+    EXPECT_EQ(g_allocationCount.load(), 1u);
+
+    ASSERT_EQ(handles.size(), definitions.size());
+    EXPECT_EQ(simulation.getCollisionPartner(handles[1]), nullptr); // Segments are skipped
+    EXPECT_EQ(simulation.getCollisionPartner(handles[5]), nullptr); // Definitions without a shape are skipped
+    RigidBody * circle = simulation.getCollisionPartner(handles[2]);
+    ASSERT_NE(dynamic_cast<Circle *>(circle), nullptr);
+    EXPECT_EQ(circle->getPosition().x, 40.0f);
+    EXPECT_EQ(circle->getAngularVelocityRadians(), 1.0f);
+    EXPECT_NE(dynamic_cast<Polygon *>(simulation.getCollisionPartner(handles[3])), nullptr);
+
+    for (bodyHandle handle : handles) {
+        simulation.deleteCollisionPartner(handle);
+    }
+}
+
+// Bodies deleted and created in the collision callback are queued and only change the simulation at the end of the step
+TEST(SimulationTest, CollisionCallbackCanDeleteBodies) {
+    Simulation & simulation = Simulation::getInstance();
+    std::vector<bodyHandle> handles;
+    for (int i = 0; i < 4; i++) {
+        handles.push_back(simulation.createCollisionPartner<Circle>(0.1f, 10.0f));
+        simulation.getCollisionPartner(handles.back())->setPosition(5000.0f + 15.0f * i, -5000.0f);
+    }
+    std::vector<bodyHandle> spawned;
+    int callCount = 0;
+    simulation.m_collisionCallback = [&](RigidBody * i_firstBody, RigidBody * i_secondBody) {
+        callCount++;
+        // Deleting the same body twice must not do any harm
+        simulation.deleteCollisionPartner(i_firstBody);
+        simulation.deleteCollisionPartner(i_secondBody);
+        spawned.push_back(simulation.createCollisionPartner<Circle>(0.1f, 1.0f));
+    };
+    simulation.step(1.0f / 120.0f);
+    simulation.m_collisionCallback = nullptr;
+
+    EXPECT_EQ(callCount, 3);
+    for (bodyHandle handle : handles) {
+        EXPECT_EQ(simulation.getCollisionPartner(handle), nullptr);
+    }
+    ASSERT_EQ(spawned.size(), 3u);
+    for (bodyHandle handle : spawned) {
+        EXPECT_NE(simulation.getCollisionPartner(handle), nullptr);
+        simulation.deleteCollisionPartner(handle);
+    }
+}
+
+// A bullet which would pass a thin wall within a single step is stopped by the continuous collision detection and bounces off in front
+TEST(SimulationTest, BulletDoesNotTunnelThroughThinWall) {
+    const float WALL_X = -5000.0f; // In pixels, away from the bodies of the other tests
+    const float RADIUS = 5.0f;     // In pixels
+    const float SPEED = 10000.0f;  // In pixels per second
+    const float DT = 1.0f / 60.0f; // In seconds, the bullet would move 167 pixels
+    Simulation & simulation = Simulation::getInstance();
+    BoundaryElement wall(200.0f);
+    wall.setPosition(WALL_X, 5000.0f);
+    wall.setRotation(90.0f);
+    simulation.addBoundaryElement(&wall);
+    bodyHandle handle = simulation.createCollisionPartner<Circle>(0.1f, RADIUS);
+    RigidBody * bullet = simulation.getCollisionPartner(handle);
+    bullet->setBullet(true);
+    bullet->setPosition(WALL_X - 100.0f, 5000.0f);
+    bullet->setVelocity(sf::Vector2f(SPEED, 0.0f));
+
+    simulation.step(DT);
+
+    EXPECT_LT(bullet->getPosition().x, WALL_X - RADIUS);
+    EXPECT_LT(bullet->getVelocity().x, 0.0f);
+    simulation.deleteCollisionPartner(handle);
+    simulation.removeBoundaryElement(&wall);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "SlowStepRecorder.hpp"
+#include "BoundaryElement.hpp"
+#include "Circle.hpp"
+#include "Polygon.hpp"
+#include "Simulation.hpp"
+#include "test_helpers.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// Only steps over the budget are recorded, and only up to the maximum number of reports
+TEST(SlowStepRecorderTest, BudgetSelectsSteps) {
+    SlowStepRecorder recorder;
+    EXPECT_FALSE(recorder.isOverBudget(1.0f)); // No budget set
+    recorder.setBudget(0.01f, "unused_", 0);
+    EXPECT_FALSE(recorder.isOverBudget(1.0f)); // No reports allowed
+    recorder.setBudget(0.01f, "unused_", 2);
+    EXPECT_FALSE(recorder.isOverBudget(0.005f));
+    EXPECT_TRUE(recorder.isOverBudget(0.02f));
+}
+
+// The report contains the phases, the counters and every shape once
+TEST(SlowStepRecorderTest, ReportContainsPhasesCountersAndWorld) {
+    std::shared_ptr<const ShapeDefinition> ball = ShapeDefinition::createCircle(5.0f);
+    Circle first(0.1f, ball);
+    Circle second(0.1f, ball);
+    second.setPosition(0.25f, -3.5f);
+    Polygon crate;
+    BoundaryElement floor(100.0f);
+    Profiler profiler;
+    profiler.addTime(profilePhase::narrowphase, std::chrono::microseconds(1500));
+    profiler.endFrame();
+    simulationStats stats;
+    stats.contactCount = 7;
+
+    SlowStepRecorder recorder;
+    recorder.setBudget(0.001f);
+    recorder.startSnapshot();
+    recorder.addToSnapshot(first);
+    recorder.addToSnapshot(second);
+    recorder.addToSnapshot(crate);
+    recorder.addToSnapshot(floor);
+    std::ostringstream report;
+    recorder.writeReport(report, 0.002f, 1.0f / 120.0f, profiler, stats);
+    std::string text = report.str();
+    EXPECT_NE(text.find("\"narrowphase\":1500"), std::string::npos);
+    EXPECT_NE(text.find("\"contactCount\":7"), std::string::npos);
+    EXPECT_NE(text.find("\"position\":[0.25,-3.5]"), std::string::npos);
+    EXPECT_NE(text.find("\"length\":100"), std::string::npos);
+    EXPECT_EQ(countOccurrences(text, "\"type\":"), 3u);
+    EXPECT_EQ(countOccurrences(text, "{\"shape\":"), 4u);
+
+    // The caller's precision is restored
+    report.str("");
+    report << 1.0 / 3.0;
+    EXPECT_EQ(report.str(), "0.333333");
+}
+
+// A step over the budget is written to disk
+TEST(SlowStepRecorderTest, SimulationWritesSlowSteps) {
+    Simulation & simulation = Simulation::getInstance();
+    SlowStepRecorder & recorder = simulation.getSlowStepRecorder();
+    recorder.setBudget(1e-9f, "test_slow_step_", 1);
+    simulation.step(1.0f / 120.0f);
+    simulation.step(1.0f / 120.0f);
+    EXPECT_EQ(recorder.getReportCount(), 1u);
+    std::ifstream file(recorder.getLastReportPath());
+    EXPECT_TRUE(file.good());
+    file.close();
+    std::remove(recorder.getLastReportPath().c_str());
+    recorder.setBudget(0.0f);
+}
+
+// The report holds the state the slow step started with, so the step can be reproduced from it
+TEST(SlowStepRecorderTest, ReportHoldsStateAtStartOfStep) {
+    Simulation & simulation = Simulation::getInstance();
+    bodyDefinition definition;
+    definition.shape = ShapeDefinition::createCircle(5.0f);
+    definition.position = sf::Vector2f(-7000.25f, 7000.5f);
+    definition.velocity = sf::Vector2f(1200.0f, 0.0f);
+    bodyHandle handle = simulation.createCollisionPartners({definition})[0];
+    SlowStepRecorder & recorder = simulation.getSlowStepRecorder();
+    recorder.setBudget(1e-9f, "test_slow_step_start_", 1);
+    simulation.step(1.0f / 120.0f);
+    recorder.setBudget(0.0f);
+    EXPECT_NE(simulation.getCollisionPartner(handle)->getPosition().x, definition.position.x);
+    simulation.deleteCollisionPartner(handle);
+
+    std::ifstream file(recorder.getLastReportPath());
+    std::stringstream report;
+    report << file.rdbuf();
+    file.close();
+    std::remove(recorder.getLastReportPath().c_str());
+    EXPECT_NE(report.str().find("\"position\":[-7000.25,7000.5]"), std::string::npos);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "Profiler.hpp"
+#include "TraceRecorder.hpp"
+#include "WorkerPool.hpp"
+#include "test_helpers.hpp"
+#include <cstddef>
+#include <sstream>
+#include <string>
+
+// Once the ring buffer is full, the oldest spans are overwritten and the trace only holds the most recent ones
+TEST(TraceRecorderTest, RingBufferKeepsNewestSpans) {
+    TraceRecorder recorder;
+    TraceRecorder::clock::time_point now = TraceRecorder::clock::now();
+    recorder.record("ignored", 0, now, now); // Not recording yet
+    EXPECT_EQ(recorder.getSpanCount(), 0u);
+
+    recorder.start(4);
+    const char * NAMES[] = {"a", "b", "c", "d", "e", "f"};
+    for (const char * name : NAMES) {
+        recorder.record(name, 0, now, now + std::chrono::microseconds(5));
+    }
+    recorder.stop();
+    recorder.record("ignored", 0, now, now);
+    EXPECT_EQ(recorder.getSpanCount(), 4u);
+    EXPECT_EQ(recorder.getDroppedSpanCount(), 2u);
+
+    std::ostringstream stream;
+    recorder.writeChromeTrace(stream);
+    std::string trace = stream.str();
+    EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0u);
+    EXPECT_EQ(countOccurrences(trace, "\"ph\":\"X\""), 4u);
+    EXPECT_EQ(trace.find("\"name\":\"b\""), std::string::npos);
+    EXPECT_LT(trace.find("\"name\":\"c\""), trace.find("\"name\":\"f\""));
+    EXPECT_NE(trace.find("\"dur\":5.000"), std::string::npos);
+    EXPECT_EQ(trace.find("ignored"), std::string::npos);
+    EXPECT_EQ(trace.substr(trace.size() - 3), "]}\n");
+}
+
+// Writing a trace leaves the formatting of the caller's stream as it was
+TEST(TraceRecorderTest, StreamFormattingIsRestored) {
+    TraceRecorder recorder;
+    std::ostringstream stream;
+    stream.precision(4);
+    recorder.writeChromeTrace(stream);
+    stream.str("");
+    stream << 0.5 << " " << 1.0 / 3.0;
+    EXPECT_EQ(stream.str(), "0.5 0.3333");
+}
+
+// The profiler records its phases and frames, the worker pool records one job span per thread
+TEST(TraceRecorderTest, PhasesAndWorkerJobsAreRecorded) {
+    TraceRecorder recorder;
+    Profiler profiler;
+    WorkerPool workerPool(2);
+    profiler.setTraceRecorder(&recorder);
+    workerPool.setTraceRecorder(&recorder);
+    recorder.start();
+
+    {
+        COLLISION2D_PROFILE_SCOPE(profiler, profilePhase::solve);
+        // Enough work for every thread to grab at least one chunk
+        auto work = [](std::size_t) {
+            TraceRecorder::clock::time_point start = TraceRecorder::clock::now();
+            while (TraceRecorder::clock::now() - start < std::chrono::microseconds(20)) {}
+        };
+        workerPool.parallelFor(300, work);
+    }
+    profiler.endFrame();
+    recorder.stop();
+
+    std::ostringstream stream;
+    recorder.writeChromeTrace(stream);
+    std::string trace = stream.str();
+    EXPECT_EQ(countOccurrences(trace, "\"name\":\"solve\""), 1u);
+    EXPECT_EQ(countOccurrences(trace, "\"name\":\"frame\""), 1u);
+    EXPECT_EQ(countOccurrences(trace, "\"name\":\"job\""), 3u);
+    EXPECT_NE(trace.find("\"name\":\"Worker 2\""), std::string::npos);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Count how often a pattern occurs in a text, e.g. the entries of a JSON report. Overlapping occurrences are counted as well.
+ * @param i_text The text to search.
+ * @param i_pattern The pattern to look for.
+ * @return The number of occurrences.
+ */
+inline std::size_t countOccurrences(const std::string & i_text, const std::string & i_pattern) {
+    std::size_t count = 0;
+    for (std::size_t position = i_text.find(i_pattern); position != std::string::npos; position = i_text.find(i_pattern, position + 1)) {
+        count++;
+    }
+    return count;
+}
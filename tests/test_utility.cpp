@@ -1,8 +1,6 @@
 #include <gtest/gtest.h>
 
-//#include "sfml_utility.hpp"
-#include "..\Collision2D\sfml_utility.cpp"
-#include "..\Collision2D\Matrix2f.cpp"
+#include "sfml_utility.hpp"
         //
 const float EPSILON = 1e-5f; // Tolerance for floating-point comparisons
 
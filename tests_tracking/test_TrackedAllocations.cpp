@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "AllocationTracker.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//*** Tests of the replaced operator new and delete ***
+//
+//This project compiles AllocationTracker.cpp with COLLISION2D_TRACK_ALLOCATIONS. It is a program of its own, because the tests project
+//replaces the global allocation functions itself to count allocations.
+//
+namespace {
+std::size_t getLiveBytes(memorySubsystem i_subsystem) {
+    return AllocationTracker::getMemory(i_subsystem).liveBytes;
+}
+
+std::uint64_t getAllocationCount(memorySubsystem i_subsystem) {
+    return AllocationTracker::getMemory(i_subsystem).allocationCount;
+}
+} // namespace
+
+TEST(TrackedAllocationsTest, IsEnabled) {
+    EXPECT_TRUE(AllocationTracker::IS_ENABLED);
+}
+
+// Every new inside a scope is counted for its subsystem with its size, and every delete subtracts it again
+TEST(TrackedAllocationsTest, NewAndDeleteAreCountedPerSubsystem) {
+    std::size_t liveBytesBefore = getLiveBytes(memorySubsystem::bodies);
+    std::uint64_t allocationCountBefore = getAllocationCount(memorySubsystem::bodies);
+    std::uint64_t deallocationCountBefore = AllocationTracker::getMemory(memorySubsystem::bodies).deallocationCount;
+
+    // Volatile, so the compiler can't leave out the allocations
+    int * volatile value = nullptr;
+    char * volatile array = nullptr;
+    {
+        COLLISION2D_MEMORY_SCOPE(memorySubsystem::bodies);
+        value = new int(42);
+        array = new char[100];
+    }
+    std::size_t liveBytesAllocated = getLiveBytes(memorySubsystem::bodies);
+    std::uint64_t allocationCountAllocated = getAllocationCount(memorySubsystem::bodies);
+    delete value;
+    delete[] array;
+    std::size_t liveBytesFreed = getLiveBytes(memorySubsystem::bodies);
+    std::uint64_t deallocationCountFreed = AllocationTracker::getMemory(memorySubsystem::bodies).deallocationCount;
+
+    EXPECT_EQ(allocationCountAllocated - allocationCountBefore, 2u);
+    EXPECT_EQ(liveBytesAllocated - liveBytesBefore, sizeof(int) + 100);
+    EXPECT_EQ(deallocationCountFreed - deallocationCountBefore, 2u);
+    EXPECT_EQ(liveBytesFreed, liveBytesBefore);
+}
+
+// A block is subtracted from the subsystem that allocated it, even if it is freed in the scope of another one
+TEST(TrackedAllocationsTest, DeleteIsAttributedToTheAllocatingSubsystem) {
+    std::size_t shapeBytesBefore = getLiveBytes(memorySubsystem::shapes);
+    std::size_t contactBytesBefore = getLiveBytes(memorySubsystem::contacts);
+
+    std::vector<float> * volatile vertices = nullptr;
+    {
+        COLLISION2D_MEMORY_SCOPE(memorySubsystem::shapes);
+        vertices = new std::vector<float>(64);
+    }
+    std::size_t shapeBytesAllocated = getLiveBytes(memorySubsystem::shapes);
+    {
+        COLLISION2D_MEMORY_SCOPE(memorySubsystem::contacts);
+        delete vertices;
+    }
+    std::size_t shapeBytesFreed = getLiveBytes(memorySubsystem::shapes);
+    std::size_t contactBytesFreed = getLiveBytes(memorySubsystem::contacts);
+
+    EXPECT_EQ(shapeBytesAllocated - shapeBytesBefore, sizeof(std::vector<float>) + 64 * sizeof(float));
+    EXPECT_GE(AllocationTracker::getMemory(memorySubsystem::shapes).peakBytes, shapeBytesAllocated);
+    EXPECT_EQ(shapeBytesFreed, shapeBytesBefore);
+    EXPECT_EQ(contactBytesFreed, contactBytesBefore);
+}
+
+// The header in front of every block must keep it aligned like a block of malloc
+TEST(TrackedAllocationsTest, BlocksAreAlignedLikeMalloc) {
+    for (std::size_t size : {1, 7, 16, 100}) {
+        char * volatile block = new char[size];
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(block);
+        delete[] block;
+        EXPECT_EQ(address % alignof(std::max_align_t), 0u) << "size " << size;
+    }
+}
+
+int main(int argc, char ** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}